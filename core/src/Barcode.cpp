@@ -27,8 +27,8 @@ void zint_symbol_deleter::operator()(zint_symbol*) const noexcept {}
 
 #endif
 
+#include <algorithm>
 #include <cmath>
-#include <list>
 #include <map>
 #include <utility>
 
@@ -82,14 +82,71 @@ ByteArray Result::bytesECI() const
 	return _content.bytesECI();
 }
 
+struct Result::TextCache::Table
+{
+	std::atomic<std::string*> texts[static_cast<int>(TextMode::Escaped) + 1] = {};
+};
+
+void Result::TextCache::clear() noexcept
+{
+	if (auto table = _table.exchange(nullptr)) {
+		for (auto& text : table->texts)
+			delete text.load();
+		delete table;
+	}
+}
+
+const std::string* Result::TextCache::find(TextMode mode) const noexcept
+{
+	auto table = _table.load(std::memory_order_acquire);
+	return table ? table->texts[static_cast<int>(mode)].load(std::memory_order_acquire) : nullptr;
+}
+
+const std::string& Result::TextCache::get(TextMode mode, const Content& content)
+{
+	// if another thread wins the race to set an entry, our copy is dropped in favor of theirs
+	auto table = _table.load(std::memory_order_acquire);
+	if (!table) {
+		auto newTable = new Table();
+		if (_table.compare_exchange_strong(table, newTable, std::memory_order_acq_rel))
+			table = newTable;
+		else
+			delete newTable;
+	}
+
+	auto& entry = table->texts[static_cast<int>(mode)];
+	auto text = entry.load(std::memory_order_acquire);
+	if (!text) {
+		auto newText = new std::string(content.text(mode));
+		if (entry.compare_exchange_strong(text, newText, std::memory_order_acq_rel))
+			text = newText;
+		else
+			delete newText;
+	}
+	return *text;
+}
+
 std::string Result::text(TextMode mode) const
 {
+	// the caller gets its own copy anyway, so there is no need to allocate a cache entry
+	if (auto text = _textCache.find(mode))
+		return *text;
 	return _content.text(mode);
 }
 
 std::string Result::text() const
 {
-	return text(_readerOpts.textMode());
+	return text(_textMode);
+}
+
+std::string_view Result::textView(TextMode mode) const
+{
+	return _textCache.get(mode, _content);
+}
+
+std::string_view Result::textView() const
+{
+	return textView(_textMode);
 }
 
 std::string Result::ecLevel() const
@@ -142,7 +199,8 @@ Result& Result::setReaderOptions(const ReaderOptions& opts)
 {
 	if (opts.characterSet() != CharacterSet::Unknown)
 		_content.defaultCharset = opts.characterSet();
-	_readerOpts = opts;
+	_textMode = opts.textMode();
+	_textCache.clear();
 	return *this;
 }
 
@@ -190,14 +248,15 @@ bool Result::operator==(const Result& o) const
 
 	// handle MatrixCodes first
 	if (!IsLinearBarcode(format())) {
-		if (bytes() != o.bytes() && isValid() && o.isValid())
+		// check for equal position first, it is cheaper than comparing the bytes of large symbols
+		if (!IsInside(Center(o.position()), position()))
 			return false;
 
-		// check for equal position if both are valid with equal bytes or at least one is in error
-		return IsInside(Center(o.position()), position());
+		// equal position is sufficient if at least one is in error
+		return !isValid() || !o.isValid() || bytes() == o.bytes();
 	}
 
-	if (bytes() != o.bytes() || error() != o.error() || orientation() != o.orientation())
+	if (orientation() != o.orientation() || bytes() != o.bytes() || error() != o.error())
 		return false;
 
 	if (lineCount() > 1 && o.lineCount() > 1)
@@ -230,19 +289,22 @@ Barcode MergeStructuredAppendSequence(const Barcodes& barcodes)
 	if (barcodes.empty())
 		return {};
 
-	std::list<Barcode> allBarcodes(barcodes.begin(), barcodes.end());
-	allBarcodes.sort([](const Barcode& r1, const Barcode& r2) { return r1.sequenceIndex() < r2.sequenceIndex(); });
+	std::vector<const Barcode*> parts;
+	parts.reserve(barcodes.size());
+	for (auto& barcode : barcodes)
+		parts.push_back(&barcode);
+	std::stable_sort(parts.begin(), parts.end(),
+					 [](const Barcode* r1, const Barcode* r2) { return r1->sequenceIndex() < r2->sequenceIndex(); });
 
-	Barcode res = allBarcodes.front();
-	for (auto i = std::next(allBarcodes.begin()); i != allBarcodes.end(); ++i)
-		res._content.append(i->_content);
+	Barcode res = *parts.front();
+	for (auto i = std::next(parts.begin()); i != parts.end(); ++i)
+		res._content.append((*i)->_content);
 
 	res._position = {};
 	res._sai.index = -1;
 
-	if (allBarcodes.back().sequenceSize() != Size(allBarcodes) ||
-		!std::all_of(allBarcodes.begin(), allBarcodes.end(),
-					 [&](Barcode& it) { return it.sequenceId() == allBarcodes.front().sequenceId(); }))
+	if (parts.back()->sequenceSize() != Size(parts) ||
+		!std::all_of(parts.begin(), parts.end(), [&](const Barcode* it) { return it->sequenceId() == parts.front()->sequenceId(); }))
 		res._error = FormatError("sequenceIDs not matching during structured append sequence merging");
 
 	return res;
@@ -250,19 +312,57 @@ Barcode MergeStructuredAppendSequence(const Barcodes& barcodes)
 
 Barcodes MergeStructuredAppendSequences(const Barcodes& barcodes)
 {
-	std::map<std::string, Barcodes> sas;
-	for (auto& barcode : barcodes) {
-		if (barcode.isPartOfSequence())
-			sas[barcode.sequenceId()].push_back(barcode);
+	StructuredAppendAssembler assembler;
+	Barcodes res;
+	for (auto& barcode : barcodes)
+		if (auto merged = assembler.add(barcode); merged.isValid())
+			res.push_back(std::move(merged));
+
+	return res;
+}
+
+Barcode StructuredAppendAssembler::add(const Barcode& barcode)
+{
+	if (!barcode.isValid() || !barcode.isPartOfSequence())
+		return {};
+
+	auto seqIt = _sequences.try_emplace({barcode.format(), barcode.sequenceId()}).first;
+	auto& seq = seqIt->second;
+	int index = barcode.sequenceIndex();
+	// the sequenceSize is 0 for PDF417 symbols that are not the last one and don't specify the count
+	if (barcode.sequenceSize() > 0) {
+		if (seq.count > 0 && seq.count != barcode.sequenceSize())
+			return {}; // a different sequence with the same id
+		seq.count = barcode.sequenceSize();
+	}
+	if ((seq.count > 0 && index >= seq.count) || !seq.parts.try_emplace(index, barcode._content).second) {
+		if (seq.parts.empty())
+			_sequences.erase(seqIt);
+		return {};
 	}
 
-	Barcodes res;
-	for (auto& [id, seq] : sas) {
-		auto barcode = MergeStructuredAppendSequence(seq);
-		if (barcode.isValid())
-			res.push_back(std::move(barcode));
+	if (seq.parts.begin()->first == index) {
+		seq.meta = barcode;
+		seq.meta._content = {};
 	}
 
+	// the indices are unique and >= 0, i.e. the sequence is complete if they are 0 to count - 1
+	if (seq.count == 0 || Size(seq.parts) != seq.count || seq.parts.rbegin()->first != seq.count - 1)
+		return {};
+
+	Barcode res = std::move(seq.meta);
+	auto part = seq.parts.begin();
+	res._content = std::move(part->second);
+	for (++part; part != seq.parts.end(); ++part)
+		res._content.append(part->second);
+
+	res._position = {};
+	res._sai.index = -1;
+	res._sai.count = seq.count;
+	res._textCache.clear();
+
+	_sequences.erase(seqIt);
+
 	return res;
 }
 
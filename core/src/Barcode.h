@@ -40,7 +40,11 @@ struct zint_symbol_deleter
 using unique_zint_symbol = std::unique_ptr<zint_symbol, zint_symbol_deleter>;
 #endif
 
+#include <atomic>
+#include <map>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace ZXing {
@@ -60,10 +64,31 @@ using Results = std::vector<Result>;
  */
 class Result
 {
+	/**
+	 * The lazily rendered textView() of each TextMode. It can be filled concurrently from const member functions, the
+	 * table and each entry are set once with a compare-exchange. Copies start with an empty cache.
+	 */
+	class TextCache
+	{
+		struct Table;
+		std::atomic<Table*> _table = nullptr;
+
+	public:
+		TextCache() = default;
+		TextCache(const TextCache&) noexcept {}
+		TextCache& operator=(const TextCache&) noexcept { return clear(), *this; }
+		~TextCache() { clear(); }
+
+		void clear() noexcept;
+		const std::string* find(TextMode mode) const noexcept;
+		const std::string& get(TextMode mode, const Content& content);
+	};
+
 	void setIsInverted(bool v) { _isInverted = v; }
 	Result& setReaderOptions(const ReaderOptions& opts);
 
 	friend Barcode MergeStructuredAppendSequence(const Barcodes&);
+	friend class StructuredAppendAssembler;
 	friend Barcodes ReadBarcodes(const ImageView&, const ReaderOptions&);
 	friend Image WriteBarcodeToImage(const Barcode&, const WriterOptions&);
 	friend void IncrementLineCount(Barcode&);
@@ -105,6 +130,14 @@ public:
 	 */
 	std::string text() const;
 
+	/**
+	 * @brief textView is the same as text() without a copy of the rendered text, which is cached for each TextMode.
+	 * The view is valid as long as this object is not modified or destroyed. Only textView() allocates the cache, a
+	 * text() call renders the text directly unless it is already cached.
+	 */
+	std::string_view textView(TextMode mode) const;
+	std::string_view textView() const;
+
 	/**
 	 * @brief ecLevel returns the error correction level of the symbol (empty string if not applicable)
 	 */
@@ -201,15 +234,17 @@ private:
 	Content _content;
 	Error _error;
 	Position _position;
-	ReaderOptions _readerOpts; // TODO: 3.0 switch order to prevent 4 padding bytes
 	StructuredAppendInfo _sai;
 	BarcodeFormat _format = BarcodeFormat::None;
 	char _ecLevel[4] = {};
 	char _version[4] = {};
 	int _lineCount = 0;
+	// the only option needed after reading, storing it instead of a copy of the ReaderOptions saves the padding as well
+	TextMode _textMode = TextMode::HRI;
 	bool _isMirrored = false;
 	bool _isInverted = false;
 	bool _readerInit = false;
+	mutable TextCache _textCache;
 #ifdef ZXING_EXPERIMENTAL_API
 	std::shared_ptr<BitMatrix> _symbol;
 	std::shared_ptr<zint_symbol> _zint;
@@ -227,4 +262,38 @@ Barcode MergeStructuredAppendSequence(const Barcodes& results);
  */
 Barcodes MergeStructuredAppendSequences(const Barcodes& barcodes);
 
+/**
+ * @brief The StructuredAppendAssembler merges Structured Append sequences whose symbols are found one after the
+ * other, e.g. in consecutive video frames or on the pages of a document.
+ *
+ * It only keeps the content of each symbol (and the meta data of one symbol per sequence), symbols that were added
+ * before are ignored. Sequences are identified by format and sequenceId().
+ */
+class StructuredAppendAssembler
+{
+	struct Sequence
+	{
+		Barcode meta; // the symbol with the lowest index so far, without its content
+		std::map<int, Content> parts;
+		int count = 0;
+	};
+	std::map<std::pair<BarcodeFormat, std::string>, Sequence> _sequences;
+
+public:
+	/**
+	 * @brief add a symbol and return the merged barcode as soon as it completes its sequence
+	 *
+	 * @return the merged barcode or an invalid Barcode if barcode is not valid, not part of a sequence or does not
+	 * complete it
+	 */
+	Barcode add(const Barcode& barcode);
+
+	/**
+	 * @brief pendingCount the number of incomplete sequences
+	 */
+	int pendingCount() const { return static_cast<int>(_sequences.size()); }
+
+	void clear() { _sequences.clear(); }
+};
+
 } // ZXing
@@ -0,0 +1,129 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BarcodeIndex.h"
+
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+
+namespace ZXing {
+
+// the grid has at most 32 x 32 cells, which keeps the number of cells covered by large symbols small
+BarcodeIndex::BarcodeIndex(int imageSize) : _cellSize(std::max(32, imageSize / 32)) {}
+
+// up to this number of entries, checking all bounding boxes is faster than maintaining and querying the grid
+constexpr int MAX_LINEAR_ENTRIES = 64;
+
+static uint32_t CellKey(int cx, int cy)
+{
+	return (uint32_t(cx & 0xFFFF) << 16) | uint32_t(cy & 0xFFFF);
+}
+
+void BarcodeIndex::addToGrid(int index)
+{
+	auto& e = _entries[index];
+	if (e.format == BarcodeFormat::None)
+		return;
+
+	int left = cell(e.left), top = cell(e.top), right = cell(e.right), bottom = cell(e.bottom);
+	// the position of a barcode gets updated for every merged line, most of the time without leaving its cells
+	if (e.cellLeft <= left && right <= e.cellRight && e.cellTop <= top && bottom <= e.cellBottom)
+		return;
+
+	// extend the referencing cells to the bounding rectangle of the old and new ones, so they stay a rectangle. Cells
+	// that the barcode does not cover anymore keep referencing it, the bounding box check in query() skips it.
+	bool isNew = e.cellLeft > e.cellRight;
+	if (!isNew) {
+		left = std::min(left, e.cellLeft), top = std::min(top, e.cellTop);
+		right = std::max(right, e.cellRight), bottom = std::max(bottom, e.cellBottom);
+	}
+	for (int cy = top; cy <= bottom; ++cy)
+		for (int cx = left; cx <= right; ++cx)
+			if (isNew || cx < e.cellLeft || cx > e.cellRight || cy < e.cellTop || cy > e.cellBottom)
+				_cells[CellKey(cx, cy)].push_back(index);
+	e.cellLeft = left, e.cellTop = top, e.cellRight = right, e.cellBottom = bottom;
+}
+
+void BarcodeIndex::insert(int index, const Barcode& barcode)
+{
+	auto bb = BoundingBox(barcode.position());
+	if (index >= Size(_entries))
+		_entries.resize(index + 1);
+	auto& e = _entries[index];
+	e.format = barcode.format();
+	e.left = bb.topLeft().x, e.top = bb.topLeft().y, e.right = bb.bottomRight().x, e.bottom = bb.bottomRight().y;
+
+	if (_useGrid) {
+		addToGrid(index);
+	} else if (Size(_entries) > MAX_LINEAR_ENTRIES) {
+		_useGrid = true;
+		for (int i = 0; i < Size(_entries); ++i)
+			addToGrid(i);
+	}
+}
+
+const std::vector<int>& BarcodeIndex::query(const Position& pos, int marginX, int marginY, BarcodeFormat format)
+{
+	auto bb = BoundingBox(pos);
+	int left = bb.topLeft().x - marginX, top = bb.topLeft().y - marginY;
+	int right = bb.bottomRight().x + marginX, bottom = bb.bottomRight().y + marginY;
+
+	auto check = [&](int index) {
+		const auto& e = _entries[index];
+		if ((format == BarcodeFormat::None || e.format == format) && e.left <= right && left <= e.right && e.top <= bottom
+			&& top <= e.bottom)
+			_candidates.push_back(index);
+	};
+
+	_candidates.clear();
+	if (!_useGrid) {
+		for (int i = 0; i < Size(_entries); ++i)
+			check(i);
+		return _candidates;
+	}
+
+	for (int cy = cell(top); cy <= cell(bottom); ++cy)
+		for (int cx = cell(left); cx <= cell(right); ++cx)
+			if (auto i = _cells.find(CellKey(cx, cy)); i != _cells.end())
+				for (int index : i->second)
+					check(index);
+
+	// symbols covering multiple cells are found more than once
+	std::sort(_candidates.begin(), _candidates.end());
+	_candidates.erase(std::unique(_candidates.begin(), _candidates.end()), _candidates.end());
+	return _candidates;
+}
+
+const std::vector<int>& BarcodeIndex::candidates(const Barcode& barcode)
+{
+	// Matrix codes are equal if the center of one is inside the other, so their bounding boxes intersect. Lines of
+	// linear codes are equal if their start points are less than half a line length apart and they have roughly the
+	// same length (see Barcode::operator==). Since only lines of equal orientation compare equal, their bounding boxes
+	// intersect along the line direction and only need to be extended perpendicular to it. The margin of 5/8 of the
+	// line length covers the case where the other one is the single line that is up to 1/4 longer.
+	if (!IsLinearBarcode(barcode.format()))
+		return query(barcode.position(), 0, 0, barcode.format());
+
+	auto dir = barcode.position().topRight() - barcode.position().topLeft();
+	bool isHorizontal = std::abs(dir.x) >= std::abs(dir.y);
+	auto bb = BoundingBox(barcode.position());
+	int length = isHorizontal ? bb.bottomRight().x - bb.topLeft().x : bb.bottomRight().y - bb.topLeft().y;
+	int margin = length * 5 / 8 + 1;
+	return isHorizontal ? query(barcode.position(), 0, margin, barcode.format())
+						: query(barcode.position(), margin, 0, barcode.format());
+}
+
+const std::vector<int>& BarcodeIndex::candidates(const Position& pos, BarcodeFormat format)
+{
+	return query(pos, 0, 0, format);
+}
+
+const std::vector<int>& BarcodeIndex::overlapping(const Position& pos)
+{
+	return query(pos, 0, 0, BarcodeFormat::None);
+}
+
+} // ZXing
@@ -0,0 +1,71 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Barcode.h"
+
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ZXing {
+
+/**
+* A spatial hash over the bounding boxes of a list of barcodes, referenced by their index into that list. It is used
+* to find the potential duplicates of a newly found symbol without comparing it to all symbols found so far, which
+* keeps the merging of results linear in the number of symbols on images with hundreds of them. As long as only a few
+* barcodes are indexed, the hash grid is not built and the queries simply check all bounding boxes.
+*
+* The index only narrows down the candidates, the caller still needs to do the actual comparison. Updating the
+* position of a listed barcode requires to insert it again.
+*/
+class BarcodeIndex
+{
+	struct Entry
+	{
+		BarcodeFormat format = BarcodeFormat::None;
+		int left = INT_MAX, top = INT_MAX, right = INT_MIN, bottom = INT_MIN;
+		// the range of grid cells that reference this entry, it only grows
+		int cellLeft = 0, cellTop = 0, cellRight = -1, cellBottom = -1;
+	};
+
+	int _cellSize;
+	bool _useGrid = false;
+	std::vector<Entry> _entries; // the current bounding box of each indexed barcode
+	std::unordered_map<uint32_t, std::vector<int>> _cells;
+	std::vector<int> _candidates;
+
+	int cell(int v) const { return (v < 0 ? v - _cellSize + 1 : v) / _cellSize; } // floor division
+	void addToGrid(int index);
+	const std::vector<int>& query(const Position& pos, int marginX, int marginY, BarcodeFormat format);
+
+public:
+	/**
+	* @param imageSize the larger of the image width and height, used to choose the cell size of the hash grid
+	*/
+	explicit BarcodeIndex(int imageSize);
+
+	void insert(int index, const Barcode& barcode);
+
+	/**
+	* The ascending list of indices of all barcodes that might compare equal to barcode, see Barcode::operator==().
+	* They are of the same format and have a bounding box close enough to the one of barcode.
+	*/
+	const std::vector<int>& candidates(const Barcode& barcode);
+
+	/**
+	* The ascending list of indices of all barcodes of the given format with a bounding box intersecting the one of pos.
+	*/
+	const std::vector<int>& candidates(const Position& pos, BarcodeFormat format);
+
+	/**
+	* The ascending list of indices of all barcodes (of any format) with a bounding box intersecting the one of pos.
+	*/
+	const std::vector<int>& overlapping(const Position& pos);
+};
+
+} // ZXing
@@ -6,6 +6,7 @@
 #include "BinaryBitmap.h"
 
 #include "BitMatrix.h"
+#include "ConcentricScan.h"
 
 #include <mutex>
 
@@ -15,6 +16,8 @@ struct BinaryBitmap::Cache
 {
 	std::once_flag once;
 	std::shared_ptr<const BitMatrix> matrix;
+	std::unique_ptr<ContrastMap> contrast;
+	ConcentricPatternCache concentricPatterns;
 };
 
 BitMatrix BinaryBitmap::binarize(const uint8_t threshold) const
@@ -57,12 +60,28 @@ const BitMatrix* BinaryBitmap::getBitMatrix() const
 	return _cache->matrix.get();
 }
 
+void BinaryBitmap::setContrastMap(ContrastMap&& map) const
+{
+	_cache->contrast = std::make_unique<ContrastMap>(std::move(map));
+}
+
+const ContrastMap* BinaryBitmap::contrastMap() const
+{
+	return _cache->contrast.get();
+}
+
+ConcentricPatternCache& BinaryBitmap::concentricPatternCache() const
+{
+	return _cache->concentricPatterns;
+}
+
 void BinaryBitmap::invert()
 {
 	if (_cache->matrix) {
 		auto matrix = const_cast<BitMatrix*>(_cache->matrix.get());
 		matrix->flipAll();
 	}
+	_cache->concentricPatterns.reset();
 	_inverted = !_inverted;
 }
 
@@ -95,6 +114,9 @@ void BinaryBitmap::close()
 		// erode
 		SumFilter(tmp, matrix, [](int sum) { return (sum == 9 * BitMatrix::SET_V) * BitMatrix::SET_V; });
 	}
+	// closing can fill the gaps in a flat line with the color of the neighboring lines
+	_cache->contrast.reset();
+	_cache->concentricPatterns.reset();
 	_closed = true;
 }
 
@@ -16,9 +16,23 @@
 namespace ZXing {
 
 class BitMatrix;
+struct ConcentricPatternCache;
 
 using PatternRow = std::vector<uint16_t>;
 
+/**
+* A summary of the local contrast of an image, collected by the HybridBinarizer from its 8x8 pixel blocks. It is
+* reduced to one entry per row and column of the image, so the readers can skip the lines without any edges, e.g. in the
+* blank areas of document pages.
+*/
+struct ContrastMap
+{
+	// all pixels of the row/column have the same color in the BitMatrix
+	std::vector<bool> flatRows, flatCols;
+	// upper bound of the luminance range (max - min) of the row/column
+	std::vector<uint8_t> rowRanges, colRanges;
+};
+
 /**
 * This class is the core bitmap class used by ZXing to represent 1 bit data. Reader objects
 * accept a BinaryBitmap and attempt to decode it.
@@ -42,6 +56,11 @@ protected:
 
 	BitMatrix binarize(const uint8_t threshold) const;
 
+	/**
+	* To be called from getBlackMatrix() by binarizers that can provide a ContrastMap for the BitMatrix they return.
+	*/
+	void setContrastMap(ContrastMap&& map) const;
+
 public:
 	BinaryBitmap(const ImageView& buffer);
 	virtual ~BinaryBitmap();
@@ -56,6 +75,18 @@ public:
 
 	const BitMatrix* getBitMatrix() const;
 
+	/**
+	* The ContrastMap of the image or nullptr if the binarizer does not provide one. It is only available after
+	* getBitMatrix() has been called, which this function does not do itself. It is reset by close().
+	*/
+	const ContrastMap* contrastMap() const;
+
+	/**
+	* Storage for the finder patterns shared between the readers, see FindConcentricPatterns(). It is reset by invert()
+	* and close().
+	*/
+	ConcentricPatternCache& concentricPatternCache() const;
+
 	void invert();
 	bool inverted() const { return _inverted; }
 
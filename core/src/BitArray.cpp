@@ -8,30 +8,42 @@
 
 #include "ByteArray.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <stdexcept>
+#include <utility>
 
 namespace ZXing {
 
+void BitArray::reverse()
+{
+	BitArray res(_size);
+	for (int i = 0; i < _size; ++i)
+		if (get(i))
+			res._words[(_size - 1 - i) / WordSize] |= Mask(_size - 1 - i);
+	_words = std::move(res._words);
+}
+
 void
 BitArray::bitwiseXOR(const BitArray& other)
 {
 	if (size() != other.size()) {
 		throw std::invalid_argument("BitArray::xor(): Sizes don't match");
 	}
-	for (size_t i = 0; i < _bits.size(); i++) {
-		// The last int could be incomplete (i.e. not have 32 bits in
-		// it) but there is no problem since 0 XOR 0 == 0.
-		_bits[i] ^= other._bits[i];
-	}
+	// the unused bits of the last word are 0 in both arrays, so they stay 0
+	for (size_t i = 0; i < _words.size(); i++)
+		_words[i] ^= other._words[i];
 }
 
 ByteArray BitArray::toBytes(int bitOffset, int numBytes) const
 {
 	ByteArray res(numBytes == -1 ? (size() - bitOffset + 7) / 8 : numBytes);
-	for (int i = 0; i < Size(res); i++)
-		for (int j = 0; j < 8; j++)
-			AppendBit(res[i], (numBytes != -1 || bitOffset < size()) ? get(bitOffset++) : 0);
+	if (numBytes != -1 && bitOffset + 8 * numBytes > size())
+		throw std::out_of_range("BitArray::toBytes");
+	for (int i = 0; i < Size(res); i++, bitOffset += 8) {
+		int n = std::clamp(size() - bitOffset, 0, 8);
+		res[i] = narrow_cast<uint8_t>(getBits(bitOffset, n) << (8 - n));
+	}
 	return res;
 }
 
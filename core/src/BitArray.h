@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -22,11 +23,13 @@ namespace ZXing {
 class ByteArray;
 
 /**
-* A simple, fast array of bits.
+* A simple, fast array of bits. The bits are packed into 64-bit words, most-significant bit first, such that reading
+* and appending multi-bit values (see getBits() and appendBits()) boils down to a few shift and mask operations.
 */
 class BitArray
 {
-	std::vector<uint8_t> _bits;
+	std::vector<uint64_t> _words;
+	int _size = 0;
 
 	friend class BitMatrix;
 
@@ -35,56 +38,141 @@ class BitArray
 	BitArray(const BitArray &) = default;
 	BitArray& operator=(const BitArray &) = delete;
 
+	static constexpr int WordSize = 64;
+	static int NumWords(int size) { return (size + WordSize - 1) / WordSize; }
+	static uint64_t Mask(int i) { return uint64_t(1) << (WordSize - 1 - i % WordSize); }
+
 public:
 
-	using Iterator = std::vector<uint8_t>::const_iterator;
+	/**
+	* Read-only iterator over the individual bits, modelled after a random access iterator with bool as value_type.
+	*/
+	class Iterator
+	{
+		const uint64_t* _words = nullptr;
+		int _pos = 0;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using difference_type = int;
+		using value_type = bool;
+		using pointer = void;
+		using reference = bool;
+
+		Iterator() = default;
+		Iterator(const uint64_t* words, int pos) : _words(words), _pos(pos) {}
+
+		bool operator*() const { return _words[_pos / WordSize] & Mask(_pos); }
+		bool operator[](int i) const { return *(*this + i); }
+
+		Iterator& operator++() { return ++_pos, *this; }
+		Iterator operator++(int) { auto temp = *this; ++_pos; return temp; }
+		Iterator& operator--() { return --_pos, *this; }
+		Iterator& operator+=(int i) { return _pos += i, *this; }
+		Iterator& operator-=(int i) { return _pos -= i, *this; }
+		Iterator operator+(int i) const { return {_words, _pos + i}; }
+		Iterator operator-(int i) const { return {_words, _pos - i}; }
+		int operator-(const Iterator& rhs) const { return _pos - rhs._pos; }
+
+		bool operator==(const Iterator& rhs) const { return _pos == rhs._pos; }
+		bool operator!=(const Iterator& rhs) const { return _pos != rhs._pos; }
+		bool operator<(const Iterator& rhs) const { return _pos < rhs._pos; }
+		bool operator<=(const Iterator& rhs) const { return _pos <= rhs._pos; }
+		bool operator>(const Iterator& rhs) const { return _pos > rhs._pos; }
+		bool operator>=(const Iterator& rhs) const { return _pos >= rhs._pos; }
+	};
 
 	BitArray() = default;
 
-	explicit BitArray(int size) : _bits(size, 0) {}
+	explicit BitArray(int size) : _words(NumWords(size), 0), _size(size) {}
 
 	BitArray(BitArray&& other) noexcept = default;
 	BitArray& operator=(BitArray&& other) noexcept = default;
 
 	BitArray copy() const { return *this; }
 
-	int size() const noexcept { return Size(_bits); }
+	int size() const noexcept { return _size; }
 
 	int sizeInBytes() const noexcept { return (size() + 7) / 8; }
 
-	bool get(int i) const { return _bits.at(i) != 0; }
-	void set(int i, bool val) { _bits.at(i) = val; }
+	void reserve(int size) { _words.reserve(NumWords(size)); }
+
+	bool get(int i) const
+	{
+		if (i < 0 || i >= _size)
+			throw std::out_of_range("BitArray::get");
+		return _words[i / WordSize] & Mask(i);
+	}
+
+	void set(int i, bool val)
+	{
+		if (i < 0 || i >= _size)
+			throw std::out_of_range("BitArray::set");
+		auto& word = _words[i / WordSize];
+		word = val ? word | Mask(i) : word & ~Mask(i);
+	}
 
 	// If you know exactly how may bits you are going to iterate
 	// and that you access bit in sequence, iterator is faster than get().
 	// However, be extremely careful since there is no check whatsoever.
 	// (Performance is the reason for the iterator to exist in the first place.)
-	Iterator iterAt(int i) const noexcept { return {_bits.cbegin() + i}; }
-	Iterator begin() const noexcept { return _bits.cbegin(); }
-	Iterator end() const noexcept { return _bits.cend(); }
+	Iterator iterAt(int i) const noexcept { return {_words.data(), i}; }
+	Iterator begin() const noexcept { return iterAt(0); }
+	Iterator end() const noexcept { return iterAt(_size); }
+
+	/**
+	* Returns the numBits (<= 64) bits starting at pos as the least-significant bits of the result, the bit at pos
+	* being the most-significant one. There is no range check, see BitArrayView for a checked variant.
+	*/
+	uint64_t getBits(int pos, int numBits) const noexcept
+	{
+		assert(0 <= numBits && numBits <= WordSize && 0 <= pos && pos + numBits <= _size);
+		if (numBits == 0)
+			return 0;
+		int i = pos / WordSize, offset = pos % WordSize;
+		uint64_t res = _words[i] << offset;
+		if (offset + numBits > WordSize)
+			res |= _words[i + 1] >> (WordSize - offset);
+		return res >> (WordSize - numBits);
+	}
 
 	/**
 	* Appends the least-significant bits, from value, in order from most-significant to
 	* least-significant. For example, appending 6 bits from 0x000001E will append the bits
 	* 0, 1, 1, 1, 1, 0 in that order.
 	*
-	* @param value {@code int} containing bits to append
-	* @param numBits bits from value to append
+	* @param value containing bits to append
+	* @param numBits bits from value to append (<= 64)
 	*/
-	void appendBits(int value, int numBits)
+	void appendBits(uint64_t value, int numBits)
 	{
-		for (; numBits; --numBits)
-			_bits.push_back((value >> (numBits-1)) & 1);
+		assert(0 <= numBits && numBits <= WordSize);
+		if (numBits == 0)
+			return;
+		int offset = _size % WordSize;
+		if (offset == 0)
+			_words.push_back(0);
+		// align the numBits to append with the most-significant bit, this also drops all other bits of value
+		value <<= WordSize - numBits;
+		_words.back() |= value >> offset;
+		if (offset + numBits > WordSize)
+			_words.push_back(value << (WordSize - offset));
+		_size += numBits;
 	}
 
-	void appendBit(bool bit) { _bits.push_back(bit); }
+	void appendBit(bool bit) { appendBits(bit, 1); }
 
-	void appendBitArray(const BitArray& other) { _bits.insert(_bits.end(), other.begin(), other.end()); }
+	void appendBitArray(const BitArray& other)
+	{
+		reserve(_size + other._size);
+		for (int i = 0; i < other._size; i += WordSize)
+			appendBits(other.getBits(i, std::min(WordSize, other._size - i)), std::min(WordSize, other._size - i));
+	}
 
 	/**
 	* Reverses all bits in the array.
 	*/
-	void reverse() { std::reverse(_bits.begin(), _bits.end()); }
+	void reverse();
 
 	void bitwiseXOR(const BitArray& other);
 
@@ -98,7 +186,8 @@ public:
 	using Range = ZXing::Range<Iterator>;
 	Range range() const { return {begin(), end()}; }
 
-	friend bool operator==(const BitArray& a, const BitArray& b) { return a._bits == b._bits; }
+	// the bits beyond _size in the last word are always 0
+	friend bool operator==(const BitArray& a, const BitArray& b) { return a._size == b._size && a._words == b._words; }
 };
 
 template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
@@ -125,12 +214,7 @@ T ToInt(const BitArray& bits, int pos = 0, int count = 8 * sizeof(T))
 	assert(0 <= pos && pos + count <= bits.size());
 
 	count = std::min(count, bits.size());
-	int res = 0;
-	auto it = bits.iterAt(pos);
-	for (int i = 0; i < count; ++i, ++it)
-		AppendBit(res, *it);
-
-	return res;
+	return static_cast<T>(bits.getBits(pos, count));
 }
 
 template <typename T = int, typename = std::enable_if_t<std::is_integral_v<T>>>
@@ -149,40 +233,37 @@ std::vector<T> ToInts(const BitArray& bits, int wordSize, int totalWords, int of
 class BitArrayView
 {
 	const BitArray& bits;
-	BitArray::Iterator cur;
+	int pos = 0;
 
 public:
-	BitArrayView(const BitArray& bits) : bits(bits), cur(bits.begin()) {}
+	BitArrayView(const BitArray& bits) : bits(bits) {}
 
 	BitArrayView& skipBits(int n)
 	{
-		if (cur + n > bits.end())
+		if (n > size())
 			throw std::out_of_range("BitArrayView::skipBits() out of range.");
-		cur += n;
+		pos += n;
 		return *this;
 	}
 
 	int peakBits(int n) const
 	{
 		assert(n <= 32);
-		if (cur + n > bits.end())
+		if (n > size())
 			throw std::out_of_range("BitArrayView::peakBits() out of range.");
-		int res = 0;
-		for (auto i = cur; n > 0; --n, i++)
-			AppendBit(res, *i);
-		return res;
+		return static_cast<int>(bits.getBits(pos, n));
 	}
 
 	int readBits(int n)
 	{
 		int res = peakBits(n);
-		cur += n;
+		pos += n;
 		return res;
 	}
 
 	int size() const
 	{
-		return narrow_cast<int>(bits.end() - cur);
+		return bits.size() - pos;
 	}
 
 	explicit operator bool() const { return size(); }
@@ -9,6 +9,7 @@
 #include "ByteArray.h"
 #include "ZXAlgorithms.h"
 
+#include <cstdint>
 #include <stdexcept>
 
 namespace ZXing {
@@ -25,39 +26,15 @@ static int ReadBitsImpl(int numBits, const ByteArray& _bytes, int available, int
 		throw std::out_of_range("BitSource::readBits: out of range");
 	}
 
-	int result = 0;
+	// load the (at most 5) bytes covering the requested bits into one word and cut them out with a shift and a mask
+	int numBytes = (_bitOffset + numBits + 7) / 8;
+	uint64_t word = 0;
+	for (int i = 0; i < numBytes; ++i)
+		word = (word << 8) | _bytes[_byteOffset + i];
+	int result = static_cast<int>((word >> (8 * numBytes - _bitOffset - numBits)) & ((uint64_t(1) << numBits) - 1));
 
-	// First, read remainder from current byte
-	if (_bitOffset > 0) {
-		int bitsLeft = 8 - _bitOffset;
-		int toRead = numBits < bitsLeft ? numBits : bitsLeft;
-		int bitsToNotRead = bitsLeft - toRead;
-		int mask = (0xFF >> (8 - toRead)) << bitsToNotRead;
-		result = (_bytes[_byteOffset] & mask) >> bitsToNotRead;
-		numBits -= toRead;
-		_bitOffset += toRead;
-		if (_bitOffset == 8) {
-			_bitOffset = 0;
-			_byteOffset++;
-		}
-	}
-
-	// Next read whole bytes
-	if (numBits > 0) {
-		while (numBits >= 8) {
-			result = (result << 8) | _bytes[_byteOffset];
-			_byteOffset++;
-			numBits -= 8;
-		}
-
-		// Finally read a partial byte
-		if (numBits > 0) {
-			int bitsToNotRead = 8 - numBits;
-			int mask = (0xFF >> bitsToNotRead) << bitsToNotRead;
-			result = (result << numBits) | ((_bytes[_byteOffset] & mask) >> bitsToNotRead);
-			_bitOffset += numBits;
-		}
-	}
+	_byteOffset += (_bitOffset + numBits) / 8;
+	_bitOffset = (_bitOffset + numBits) % 8;
 
 	return result;
 }
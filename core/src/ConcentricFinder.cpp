@@ -116,7 +116,7 @@ std::optional<PointF> CenterOfRings(const BitMatrix& image, PointF center, int r
 	return sum / n;
 }
 
-static std::vector<PointF> CollectRingPoints(const BitMatrix& image, PointF center, int range, int edgeIndex, bool backup)
+std::vector<PointF> CollectRingPoints(const BitMatrix& image, PointF center, int range, int edgeIndex, bool backup)
 {
 	PointI centerI(center);
 	int radius = range;
@@ -11,6 +11,7 @@
 #include "ZXAlgorithms.h"
 
 #include <optional>
+#include <vector>
 
 namespace ZXing {
 
@@ -99,6 +100,8 @@ int CheckSymmetricPattern(BitMatrixCursorI& cur, PATTERN pattern, int range, boo
 
 std::optional<PointF> CenterOfRing(const BitMatrix& image, PointI center, int range, int nth, bool requireCircle = true);
 
+std::vector<PointF> CollectRingPoints(const BitMatrix& image, PointF center, int range, int edgeIndex, bool backup);
+
 std::optional<PointF> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize);
 
 std::optional<QuadrilateralF> FitSquareToPoints(const BitMatrix& image, PointF center, int range, int lineIndex, bool backup);
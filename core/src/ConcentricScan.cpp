@@ -0,0 +1,139 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ConcentricScan.h"
+
+#include "BinaryBitmap.h"
+#include "BitMatrix.h"
+#include "ReaderOptions.h"
+#include "ZXAlgorithms.h"
+#include "aztec/AZDetector.h"
+#include "maxicode/MCDetector.h"
+#include "qrcode/QRDetector.h"
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+namespace ZXing {
+
+using ConcentricPatterns = std::vector<ConcentricPattern>;
+
+static void ScanRows(const BitMatrix& image, int yBegin, int yEnd, const std::vector<ConcentricRowScan>& scans,
+					 const ContrastMap* contrast, std::vector<ConcentricPatterns>& res)
+{
+	PatternRow row;
+	for (int y = yBegin; y < yEnd; ++y) {
+		if (contrast && contrast->flatRows[y])
+			continue;
+		bool haveRow = false;
+		for (size_t i = 0; i < scans.size(); ++i) {
+			const auto& scan = scans[i];
+			if (y < scan.yBegin || y >= scan.yEnd || (y - scan.yBegin) % scan.skip != 0)
+				continue;
+			if (!std::exchange(haveRow, true))
+				GetPatternRow(image, y, row, false);
+			scan.processRow(image, y, row, res[i]);
+		}
+	}
+}
+
+int ConcentricScanBands(const std::vector<ConcentricRowScan>& scans, int maxThreads)
+{
+	constexpr int MIN_BAND_ROWS = 128; // minimal number of scanned rows per band
+	constexpr int MAX_BANDS     = 8;
+
+	if (maxThreads <= 0)
+		maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+
+	int nbRows = 0;
+	for (const auto& scan : scans)
+		nbRows += std::max(0, (scan.yEnd - scan.yBegin + scan.skip - 1) / scan.skip);
+	return std::max(1, std::min({maxThreads, nbRows / MIN_BAND_ROWS, MAX_BANDS}));
+}
+
+std::vector<ConcentricPatterns> ScanRowsForConcentricPatterns(const BitMatrix& image, const std::vector<ConcentricRowScan>& scans,
+															  const ContrastMap* contrast, int nbBands)
+{
+	std::vector<ConcentricPatterns> res(scans.size());
+
+	if (nbBands <= 0)
+		nbBands = ConcentricScanBands(scans, 0);
+	nbBands = std::min(nbBands, image.height());
+#ifdef PRINT_DEBUG
+	nbBands = 1; // the LogMatrix is not thread safe
+#endif
+
+	if (nbBands < 2) {
+		ScanRows(image, 0, image.height(), scans, contrast, res);
+		return res;
+	}
+
+	auto bandBegin = [&](int band) { return image.height() * band / nbBands; };
+
+	std::vector<std::vector<ConcentricPatterns>> bands(nbBands, std::vector<ConcentricPatterns>(scans.size()));
+	std::vector<std::future<void>> futures;
+	futures.reserve(nbBands - 1);
+	for (int b = 1; b < nbBands; ++b)
+		futures.push_back(std::async(std::launch::async, [&, b] { ScanRows(image, bandBegin(b), bandBegin(b + 1), scans, contrast, bands[b]); }));
+	ScanRows(image, bandBegin(0), bandBegin(1), scans, contrast, bands[0]);
+	for (auto& f : futures)
+		f.get();
+
+	for (size_t i = 0; i < scans.size(); ++i)
+		for (const auto& band : bands)
+			for (const auto& p : band[i])
+				if (FindIf(res[i], [&p](const auto& old) { return distance(p, old) < old.size / 2; }) == res[i].end())
+					res[i].push_back(p);
+
+	return res;
+}
+
+std::vector<ConcentricPattern> FindConcentricPatterns(const BinaryBitmap& image, BarcodeFormat format, const ReaderOptions& opts)
+{
+	auto binImg = image.getBitMatrix();
+	if (binImg == nullptr)
+		return {};
+
+	auto& cache = image.concentricPatternCache();
+	std::lock_guard lock(cache.mutex);
+
+	if (!cache.formats.testFlag(format)) {
+		auto enabled = opts.formats().empty() ? BarcodeFormats(BarcodeFormat::Any) : opts.formats();
+		auto wanted = [&](BarcodeFormat f, BarcodeFormats fs) {
+			return !cache.formats.testFlag(f) && (f == format || (opts.maxNumberOfSymbols() != 1 && enabled.testFlags(fs)));
+		};
+
+		std::vector<ConcentricRowScan> scans;
+		std::vector<std::pair<BarcodeFormat, ConcentricPatterns*>> targets;
+		if (wanted(BarcodeFormat::QRCode, BarcodeFormat::QRCode | BarcodeFormat::MicroQRCode | BarcodeFormat::RMQRCode)) {
+			scans.push_back(QRCode::FinderPatternRowScan(*binImg, opts.tryHarder()));
+			targets.emplace_back(BarcodeFormat::QRCode, &cache.qrCode);
+		}
+		if (wanted(BarcodeFormat::Aztec, BarcodeFormat::Aztec)) {
+			scans.push_back(Aztec::FinderPatternRowScan(*binImg, opts.tryHarder()));
+			targets.emplace_back(BarcodeFormat::Aztec, &cache.aztec);
+		}
+		if (wanted(BarcodeFormat::MaxiCode, BarcodeFormat::MaxiCode)) {
+			scans.push_back(MaxiCode::BullseyeRowScan(*binImg, opts.tryHarder()));
+			targets.emplace_back(BarcodeFormat::MaxiCode, &cache.maxiCode);
+		}
+
+		auto res = ScanRowsForConcentricPatterns(*binImg, scans, image.contrastMap(), ConcentricScanBands(scans, opts.maxThreads()));
+		for (size_t i = 0; i < targets.size(); ++i) {
+			cache.formats |= targets[i].first;
+			*targets[i].second = std::move(res[i]);
+		}
+	}
+
+	switch (format) {
+	case BarcodeFormat::QRCode: return cache.qrCode;
+	case BarcodeFormat::Aztec: return cache.aztec;
+	case BarcodeFormat::MaxiCode: return cache.maxiCode;
+	default: return {};
+	}
+}
+
+} // ZXing
@@ -0,0 +1,80 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BarcodeFormat.h"
+#include "ConcentricFinder.h"
+#include "Pattern.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ZXing {
+
+class BinaryBitmap;
+class BitMatrix;
+class ReaderOptions;
+struct ContrastMap;
+
+/**
+* The symbology specific part of a horizontal scan for concentric finder patterns: every skip-th row from yBegin up to
+* (but excluding) yEnd is passed to processRow() as a run-length encoded PatternRow. It appends the center of every
+* pattern it could locate to res, which also contains the patterns found in the previous rows.
+*/
+struct ConcentricRowScan
+{
+	int yBegin, yEnd, skip;
+	void (*processRow)(const BitMatrix& image, int y, const PatternRow& row, std::vector<ConcentricPattern>& res);
+};
+
+/**
+* Run all scans in a single pass over the rows of image, meaning each row is run-length encoded at most once. On large
+* images, the rows are split into bands that are searched in parallel. Patterns crossing a band border are found in both
+* bands, the duplicates are removed while merging the results in top to bottom order.
+* @param contrast if given, the rows it marks as flat are skipped, as they can not contain any pattern
+* @param nbBands the number of bands (and threads) to use, 0 means ConcentricScanBands(scans, 0)
+* @return one list of patterns per scan
+*/
+std::vector<std::vector<ConcentricPattern>> ScanRowsForConcentricPatterns(const BitMatrix& image,
+																		  const std::vector<ConcentricRowScan>& scans,
+																		  const ContrastMap* contrast = nullptr, int nbBands = 0);
+
+/**
+* The number of bands ScanRowsForConcentricPatterns() splits the rows into by default. It depends on the number of rows
+* to scan, there are at least 128 rows per band and at most 8 bands.
+* @param maxThreads upper limit of the number of bands, 0 means std::thread::hardware_concurrency()
+*/
+int ConcentricScanBands(const std::vector<ConcentricRowScan>& scans, int maxThreads);
+
+/**
+* The per BinaryBitmap storage of FindConcentricPatterns() results.
+*/
+struct ConcentricPatternCache
+{
+	std::mutex mutex;
+	BarcodeFormats formats; // the formats the bitmap has been scanned for
+	std::vector<ConcentricPattern> qrCode, aztec, maxiCode;
+
+	void reset()
+	{
+		std::lock_guard lock(mutex);
+		formats = {};
+		qrCode.clear();
+		aztec.clear();
+		maxiCode.clear();
+	}
+};
+
+/**
+* Returns the finder pattern candidates of the QRCode (which includes MicroQRCode and RMQRCode), Aztec or MaxiCode reader.
+*
+* If more than one symbol is requested, the bitmap is scanned for the finder patterns of all enabled formats in a single
+* pass on the first call and the results are cached in the bitmap. Otherwise only the requested format is scanned for,
+* since the reader of another format might not get to run at all.
+*/
+std::vector<ConcentricPattern> FindConcentricPatterns(const BinaryBitmap& image, BarcodeFormat format, const ReaderOptions& opts);
+
+} // ZXing
@@ -97,12 +97,28 @@ bool Content::canProcess() const
 	return std::all_of(encodings.begin(), encodings.end(), [](Encoding e) { return CanProcess(e.eci); });
 }
 
+bool Content::isVerbatimUtf8() const
+{
+	// an unknown ECI is rendered with the defaultCharset or a guessed one (ISO8859_1, UTF8 or Shift_JIS)
+	auto isAsciiCompatible = [](ECI eci) { return eci == ECI::Unknown || IsAsciiCompatible(eci); };
+	if (isAsciiCompatible(ToECI(defaultCharset))
+		&& std::all_of(encodings.begin(), encodings.end(), [&](Encoding e) { return isAsciiCompatible(e.eci); })
+		&& IsAscii(bytes))
+		return true;
+
+	return encodings.size() == 1 && encodings.front().pos == 0 && encodings.front().eci == ECI::UTF8 && IsValidUtf8(bytes.asString());
+}
+
 std::string Content::render(bool withECI) const
 {
 	if (empty() || !canProcess())
 		return {};
 
 #ifdef ZXING_READERS
+	// the most common case of ASCII or UTF-8 content does not need any conversion (and no encoding guessing)
+	if (!withECI && isVerbatimUtf8())
+		return std::string(bytes.asString());
+
 	std::string res;
 	res.reserve(bytes.size() * 2);
 	if (withECI)
@@ -41,6 +41,7 @@ class Content
 	void ForEachECIBlock(FUNC f) const;
 
 	void switchEncoding(ECI eci, bool isECI);
+	bool isVerbatimUtf8() const;
 	std::string render(bool withECI) const;
 
 public:
@@ -59,6 +59,15 @@ inline constexpr bool IsText(ECI eci)
 	return ToInt(eci) >= 0 && ToInt(eci) <= 170;
 }
 
+/**
+ * @brief IsAsciiCompatible is true for ECIs that map every byte < 0x80 to the same code point (see libzueci)
+ */
+inline constexpr bool IsAsciiCompatible(ECI eci)
+{
+	int v = ToInt(eci);
+	return (v >= 0 && v <= 32 && v != 14 && v != 19 && v != ToInt(ECI::UTF16BE)) || eci == ECI::ISO646_Inv || eci == ECI::Binary;
+}
+
 inline constexpr bool CanProcess(ECI eci)
 {
 	// see https://github.com/zxing-cpp/zxing-cpp/commit/d8587545434d533c4e568181e1c12ef04a8e42d9#r74864359
@@ -7,6 +7,14 @@
 
 namespace ZXing {
 
+const char* Error::Copy(std::string_view msg)
+{
+	auto res = new char[msg.size() + 1];
+	msg.copy(res, msg.size());
+	res[msg.size()] = '\0';
+	return res;
+}
+
 std::string Error::location() const
 {
 	if (!_file)
@@ -20,7 +28,7 @@ std::string ToString(const Error& e)
 	const char* name[] = {"", "FormatError", "ChecksumError", "Unsupported"};
 	std::string ret = name[static_cast<int>(e.type())];
 	if (!e.msg().empty())
-		ret += " (" + e.msg() + ")";
+		ret.append(" (").append(e.msg()).append(")");
 	if (auto location = e.location(); !location.empty())
 		ret += " @ " + e.location();
 	return ret;
@@ -5,8 +5,10 @@
 
 #pragma once
 
-#include <string>
 #include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
 
 namespace ZXing {
 
@@ -22,10 +24,11 @@ namespace ZXing {
  * caught before leaking into user/wrapper code, i.e. the functions of the public
  * API should be considered `noexcept` with respect to this class.
  *
- * Looking at the implementation of std::runtime_exception, it might actually be of
- * interest to replace the std::string msg member with a std::runtime_exception base
- * class, thereby reducing sizeof(Error) by 16 bytes. This would be a breaking ABI
- * change and would therefore have to wait for release 3.0. (TODO)
+ * Most decoding attempts fail, hence creating, copying and moving an Error should not
+ * allocate: the string literal message of the FormatError() etc. macros is referenced,
+ * not copied, and the human readable text including the location is only assembled in
+ * ToString(). Any other message (std::string, char pointer or array) is copied and owned
+ * by the Error object.
  */
 
 class Error
@@ -33,14 +36,45 @@ class Error
 public:
 	enum class Type : uint8_t { None, Format, Checksum, Unsupported };
 	Type type() const noexcept { return _type; }
-	const std::string& msg() const noexcept { return _msg; }
+	std::string_view msg() const noexcept { return _msg ? _msg : ""; }
 	explicit operator bool() const noexcept { return _type != Type::None; }
 
 	std::string location() const;
 
 	Error() = default;
-	Error(Type type, std::string msg = {}) : _msg(std::move(msg)), _type(type) {}
-	Error(const char* file, short line, Type type, std::string msg = {}) : _msg(std::move(msg)), _file(file), _line(line), _type(type) {}
+	Error(Type type) noexcept : _type(type) {}
+	Error(const char* file, short line, Type type) noexcept : _file(file), _line(line), _type(type) {}
+	// only to be used by the macros below: they make sure msg is a string literal (static storage duration), which
+	// can therefore be referenced without a copy
+	struct LiteralTag {};
+	Error(const char* file, short line, Type type, LiteralTag, const char* msg) noexcept
+		: _msg(msg), _file(file), _line(line), _type(type)
+	{}
+	// any other message is copied
+	Error(Type type, const std::string& msg) : _msg(Copy(msg)), _ownsMsg(true), _type(type) {}
+	Error(const char* file, short line, Type type, const std::string& msg)
+		: _msg(Copy(msg)), _file(file), _line(line), _ownsMsg(true), _type(type)
+	{}
+
+	Error(const Error& o)
+		: _msg(o._ownsMsg ? Copy(o._msg) : o._msg), _file(o._file), _line(o._line), _ownsMsg(o._ownsMsg), _type(o._type)
+	{}
+	Error(Error&& o) noexcept
+		: _msg(std::exchange(o._msg, nullptr)), _file(o._file), _line(o._line), _ownsMsg(std::exchange(o._ownsMsg, false)),
+		  _type(o._type)
+	{}
+	Error& operator=(Error o) noexcept
+	{
+		std::swap(_msg, o._msg);
+		std::swap(_ownsMsg, o._ownsMsg);
+		_file = o._file, _line = o._line, _type = o._type;
+		return *this;
+	}
+	~Error()
+	{
+		if (_ownsMsg)
+			delete[] _msg;
+	}
 
 	static constexpr auto Format = Type::Format;
 	static constexpr auto Checksum = Type::Checksum;
@@ -48,14 +82,17 @@ public:
 
 	inline bool operator==(const Error& o) const noexcept
 	{
-		return _type == o._type && _msg == o._msg && _file == o._file && _line == o._line;
+		return _type == o._type && msg() == o.msg() && _file == o._file && _line == o._line;
 	}
 	inline bool operator!=(const Error& o) const noexcept { return !(*this == o); }
 
 protected:
-	std::string _msg;
+	static const char* Copy(std::string_view msg);
+
+	const char* _msg = nullptr;
 	const char* _file = nullptr;
 	short _line = -1;
+	bool _ownsMsg = false;
 	Type _type = Type::None;
 };
 
@@ -64,9 +101,10 @@ inline bool operator!=(const Error& e, Error::Type t) noexcept { return !(e == t
 inline bool operator==(Error::Type t, const Error& e) noexcept { return e.type() == t; }
 inline bool operator!=(Error::Type t, const Error& e) noexcept { return !(t == e); }
 
-#define FormatError(...) Error(__FILE__, __LINE__, Error::Format, std::string(__VA_ARGS__))
-#define ChecksumError(...) Error(__FILE__, __LINE__, Error::Checksum, std::string(__VA_ARGS__))
-#define UnsupportedError(...) Error(__FILE__, __LINE__, Error::Unsupported, std::string(__VA_ARGS__))
+// the "" prefix makes sure the optional message is a string literal, use the constructor for dynamic messages
+#define FormatError(...) Error(__FILE__, __LINE__, Error::Format, Error::LiteralTag{}, "" __VA_ARGS__)
+#define ChecksumError(...) Error(__FILE__, __LINE__, Error::Checksum, Error::LiteralTag{}, "" __VA_ARGS__)
+#define UnsupportedError(...) Error(__FILE__, __LINE__, Error::Unsupported, Error::LiteralTag{}, "" __VA_ARGS__)
 
 std::string ToString(const Error& e);
 
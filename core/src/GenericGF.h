@@ -9,11 +9,53 @@
 #include "GenericGFPoly.h"
 #include "ZXConfig.h"
 
+#include <cassert>
 #include <stdexcept>
-#include <vector>
 
 namespace ZXing {
 
+/**
+* The exp and log tables of GF(SIZE) using the given primitive polynomial, generated at compile-time.
+*
+* PRIMITIVE: irreducible polynomial whose coefficients are represented by the bits of an int, where the
+*  least-significant bit represents the constant coefficient
+*/
+template <int PRIMITIVE, int SIZE_>
+struct GFTables
+{
+	static constexpr int SIZE = SIZE_;
+#ifdef ZX_REED_SOLOMON_USE_MORE_MEMORY_FOR_SPEED
+	static constexpr int EXP_SIZE = SIZE * 2;
+#else
+	static constexpr int EXP_SIZE = SIZE;
+#endif
+	short exp[EXP_SIZE] = {};
+	short log[SIZE] = {};
+
+	constexpr GFTables()
+	{
+		int x = 1;
+		for (int i = 0; i < SIZE; ++i) {
+			exp[i] = x;
+			x *= 2; // we're assuming the generator alpha is 2
+			if (x >= SIZE) {
+				x ^= PRIMITIVE;
+				x &= SIZE - 1;
+			}
+		}
+
+		for (int i = SIZE; i < EXP_SIZE; ++i)
+			exp[i] = exp[i - (SIZE - 1)];
+
+		for (int i = 0; i < SIZE - 1; ++i)
+			log[exp[i]] = i;
+		// log[0] == 0 but this should never be used
+	}
+};
+
+template <int PRIMITIVE, int SIZE>
+inline constexpr GFTables<PRIMITIVE, SIZE> GF_TABLES = {};
+
 /**
 * <p>This class contains utility methods for performing mathematical operations over
 * the Galois Fields. Operations use a given primitive polynomial in calculations.</p>
@@ -27,25 +69,25 @@ namespace ZXing {
 */
 class GenericGF
 {
-	const int _size;
+	int _size;
 	int _generatorBase;
-	std::vector<short> _expTable;
-	std::vector<short> _logTable;
+	const short* _expTable;
+	const short* _logTable;
 
+public:
 	/**
-	* Create a representation of GF(size) using the given primitive polynomial.
+	* Create a representation of GF(size) based on the given (compile-time generated) exp and log tables.
 	*
-	* @param primitive irreducible polynomial whose coefficients are represented by
-	*  the bits of an int, where the least-significant bit represents the constant
-	*  coefficient
-	* @param size the size of the field (m = log2(size) is called the word size of the encoding)
+	* @param tables the exp and log tables, see GFTables
 	* @param b the factor b in the generator polynomial can be 0- or 1-based
 	*  (g(x) = (x+a^b)(x+a^(b+1))...(x+a^(b+2t-1))).
 	*  In most cases it should be 1, but for QR code it is 0.
 	*/
-	GenericGF(int primitive, int size, int b);
+	template <typename TABLES>
+	constexpr GenericGF(const TABLES& tables, int b) noexcept
+		: _size(TABLES::SIZE), _generatorBase(b), _expTable(tables.exp), _logTable(tables.log)
+	{}
 
-public:
 	static const GenericGF& AztecData12();
 	static const GenericGF& AztecData10();
 	static const GenericGF& AztecData6();
@@ -62,31 +104,33 @@ public:
 	/**
 	* @return 2 to the power of a in GF(size)
 	*/
-	int exp(int a) const {
-		return _expTable.at(a);
+	constexpr int exp(int a) const {
+		assert(a >= 0 && a < _size);
+		return _expTable[a];
 	}
 
 	/**
 	* @return base 2 log of a in GF(size)
 	*/
-	int log(int a) const {
+	constexpr int log(int a) const {
 		if (a == 0) {
 			throw std::invalid_argument("a == 0");
 		}
-		return _logTable.at(a);
+		assert(a > 0 && a < _size);
+		return _logTable[a];
 	}
 
 	/**
 	* @return multiplicative inverse of a
 	*/
-	int inverse(int a) const {
+	constexpr int inverse(int a) const {
 		return _expTable[_size - log(a) - 1];
 	}
 
 	/**
 	* @return product of a and b in GF(size)
 	*/
-	int multiply(int a, int b) const noexcept {
+	constexpr int multiply(int a, int b) const noexcept {
 		if (a == 0 || b == 0)
 			return 0;
 
@@ -102,11 +146,11 @@ public:
 #endif
 	}
 
-	int size() const noexcept {
+	constexpr int size() const noexcept {
 		return _size;
 	}
 
-	int generatorBase() const noexcept {
+	constexpr int generatorBase() const noexcept {
 		return _generatorBase;
 	}
 };
@@ -103,6 +103,22 @@ static int EstimateBlackPoint(const Histogram& buckets)
 	return bestValley << LUMINANCE_SHIFT;
 }
 
+// The histogram of a line with a luminance range of at most 16 has no two peaks that are more than 2 buckets apart, which
+// is too little contrast for EstimateBlackPoint() to succeed.
+static constexpr int MAX_FLAT_RANGE = (LUMINANCE_BUCKETS / 16) << LUMINANCE_SHIFT;
+
+static bool IsFlatLine(const ContrastMap* contrast, int width, int height, int row, int rotation)
+{
+	if (!contrast)
+		return false;
+	switch ((rotation + 360) % 360) {
+	case 90: return contrast->colRanges[row] <= MAX_FLAT_RANGE;
+	case 180: return contrast->rowRanges[height - 1 - row] <= MAX_FLAT_RANGE;
+	case 270: return contrast->colRanges[width - 1 - row] <= MAX_FLAT_RANGE;
+	}
+	return contrast->rowRanges[row] <= MAX_FLAT_RANGE;
+}
+
 bool GlobalHistogramBinarizer::getPatternRow(int row, int rotation, PatternRow& res) const
 {
 	auto buffer = _buffer.rotated(rotation);
@@ -111,6 +127,10 @@ bool GlobalHistogramBinarizer::getPatternRow(int row, int rotation, PatternRow&
 	if (buffer.width() < 3)
 		return false; // special casing the code below for a width < 3 makes no sense
 
+	// skip the histogram if the HybridBinarizer already knows the line is flat
+	if (IsFlatLine(contrastMap(), width(), height(), row, rotation))
+		return false;
+
 #if defined(__AVX__) // or defined(__ARM_NEON)
 	// If we are extracting a column (instead of a row), we run into cache misses on every pixel access both
 	// during the histogram calculation and during the sharpen+threshold operation. Additionally, if we
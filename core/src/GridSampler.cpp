@@ -7,6 +7,8 @@
 
 #include "GridSampler.h"
 
+#include <algorithm>
+
 #ifdef PRINT_DEBUG
 #include "LogMatrix.h"
 #include "BitMatrixIO.h"
@@ -42,6 +44,29 @@ DetectorResult SampleGrid(const BitMatrix& image, int width, int height, const R
 
 	BitMatrix res(width, height);
 	for (auto&& [x0, x1, y0, y1, mod2Pix] : rois) {
+#ifndef PRINT_DEBUG
+		// If the projection of the roi is convex and the outermost sample points (the centers of the corner modules) are
+		// well inside the image, all sample points are as well. In that case, the points are projected row by row and the
+		// image is accessed without any bounds checks.
+		auto corners = QuadrilateralF(centered(PointI(x0, y0)), centered(PointI(x1 - 1, y0)), centered(PointI(x1 - 1, y1 - 1)),
+									  centered(PointI(x0, y1 - 1)));
+		if (mod2Pix.isPerspectiveIn(corners)
+			&& std::all_of(corners.begin(), corners.end(), [&](PointF p) { return image.isIn(mod2Pix(p), 1); })) {
+			constexpr int N = 8; // batch size that lets the compiler vectorize the projection
+			PointF::value_t xs[N], ys[N];
+			const auto* bits = image.row(0).begin();
+			for (int y = y0; y < y1; ++y) {
+				auto* dst = res.row(y).begin();
+				for (int x = x0; x < x1; x += N) {
+					int n = std::min(N, x1 - x);
+					mod2Pix.projectRow(centered(PointI{x, y}), n, xs, ys);
+					for (int i = 0; i < n; ++i)
+						dst[x + i] = bits[static_cast<int>(ys[i]) * image.width() + static_cast<int>(xs[i])];
+				}
+			}
+			continue;
+		}
+#endif
 		for (int y = y0; y < y1; ++y)
 			for (int x = x0; x < x1; ++x) {
 				auto p = mod2Pix(centered(PointI{x, y}));
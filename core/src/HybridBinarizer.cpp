@@ -187,14 +187,18 @@ static std::shared_ptr<BitMatrix> CalculateMatrix(const uint8_t* __restrict lumi
 
 #else
 
-// Subdivide the image in blocks of BLOCK_SIZE and calculate one treshold value per block as
-// (max - min > MIN_DYNAMIC_RANGE) ? (max + min) / 2 : 0
-static Matrix<T_t> BlockThresholds(const ImageView iv)
+struct MinMax
+{
+	uint8_t min, max;
+};
+
+// Subdivide the image in blocks of BLOCK_SIZE and calculate the min and max luminance of each block
+static Matrix<MinMax> BlockMinMax(const ImageView iv)
 {
 	int subWidth = (iv.width() + BLOCK_SIZE - 1) / BLOCK_SIZE; // ceil(width/BS)
 	int subHeight = (iv.height() + BLOCK_SIZE - 1) / BLOCK_SIZE; // ceil(height/BS)
 
-	Matrix<T_t> thresholds(subWidth, subHeight);
+	Matrix<MinMax> blocks(subWidth, subHeight);
 
 	for (int y = 0; y < subHeight; y++) {
 		int y0 = std::min(y * BLOCK_SIZE, iv.height() - BLOCK_SIZE);
@@ -208,10 +212,24 @@ static Matrix<T_t> BlockThresholds(const ImageView iv)
 					UpdateMinMax(min, max, line[xx]);
 			}
 
-			thresholds(x, y) = (max - min > MIN_DYNAMIC_RANGE) ? (int(max) + min) / 2 : 0;
+			blocks(x, y) = {min, max};
 		}
 	}
 
+	return blocks;
+}
+
+// Calculate one treshold value per block as (max - min > MIN_DYNAMIC_RANGE) ? (max + min) / 2 : 0
+static Matrix<T_t> BlockThresholds(const Matrix<MinMax>& blocks)
+{
+	Matrix<T_t> thresholds(blocks.width(), blocks.height());
+
+	for (int y = 0; y < blocks.height(); y++)
+		for (int x = 0; x < blocks.width(); x++) {
+			auto [min, max] = blocks(x, y);
+			thresholds(x, y) = (max - min > MIN_DYNAMIC_RANGE) ? (int(max) + min) / 2 : 0;
+		}
+
 	return thresholds;
 }
 
@@ -287,13 +305,55 @@ static std::shared_ptr<BitMatrix> ThresholdImage(const ImageView iv, const Matri
 	return matrix;
 }
 
+// Summarize the blocks along each row and column of the image, see ContrastMap. A line of the BitMatrix is flat if all
+// blocks it crosses are thresholded to the same uniform color. Like in ThresholdImage(), the last block of a row/column
+// overlaps the previous one and the later block determines the result.
+static ContrastMap CalculateContrastMap(const ImageView iv, const Matrix<MinMax>& blocks, const Matrix<T_t>& thresholds)
+{
+	enum { WHITE, BLACK, MIXED };
+	Matrix<uint8_t> colors(blocks.width(), blocks.height());
+	for (int y = 0; y < blocks.height(); y++)
+		for (int x = 0; x < blocks.width(); x++) {
+			auto [min, max] = blocks(x, y);
+			auto t = thresholds(x, y);
+			colors(x, y) = max <= t ? BLACK : min > t ? WHITE : MIXED;
+		}
+
+	ContrastMap res;
+	auto summarize = [&](int nLines, int nBlocks, int length, auto block, std::vector<bool>& flat, std::vector<uint8_t>& ranges) {
+		flat.resize(length);
+		ranges.resize(length);
+		for (int i = 0; i < nLines; ++i) {
+			int color = colors.get(block(i, 0));
+			uint8_t min = 255, max = 0;
+			for (int j = 0; j < nBlocks; ++j) {
+				if (colors.get(block(i, j)) != color)
+					color = MIXED;
+				min = std::min(min, blocks.get(block(i, j)).min);
+				max = std::max(max, blocks.get(block(i, j)).max);
+			}
+			int begin = std::min(i * BLOCK_SIZE, length - BLOCK_SIZE);
+			std::fill_n(flat.begin() + begin, BLOCK_SIZE, color != MIXED);
+			std::fill_n(ranges.begin() + begin, BLOCK_SIZE, max - min);
+		}
+	};
+	summarize(blocks.height(), blocks.width(), iv.height(), [](int i, int j) { return PointI(j, i); }, res.flatRows, res.rowRanges);
+	summarize(blocks.width(), blocks.height(), iv.width(), [](int i, int j) { return PointI(i, j); }, res.flatCols, res.colRanges);
+
+	return res;
+}
+
 #endif
 
 std::shared_ptr<const BitMatrix> HybridBinarizer::getBlackMatrix() const
 {
 	if (width() >= WINDOW_SIZE && height() >= WINDOW_SIZE) {
 #ifdef USE_NEW_ALGORITHM
-		auto thrs = SmoothThresholds(BlockThresholds(_buffer));
+		auto blocks = BlockMinMax(_buffer);
+		auto thrs = SmoothThresholds(BlockThresholds(blocks));
+		// ThresholdBlock() and BlockMinMax() only look at the same pixels if the pixel stride is 1
+		if (_buffer.pixStride() == 1)
+			setContrastMap(CalculateContrastMap(_buffer, blocks, thrs));
 		return ThresholdImage(_buffer, thrs);
 #else
 		const uint8_t* luminances = _buffer.data();
@@ -78,4 +78,34 @@ PointF PerspectiveTransform::operator()(PointF p) const
 	return {(a11 * p.x + a21 * p.y + a31) / denominator, (a12 * p.x + a22 * p.y + a32) / denominator};
 }
 
+void PerspectiveTransform::projectRow(PointF p, int n, value_t* xs, value_t* ys) const
+{
+	// the numerators and the denominator change linearly along the row (forward differencing), writing it as
+	// 'start + i * step' instead of accumulating the steps prevents error accumulation and helps auto-vectorization
+	auto nx = a11 * p.x + a21 * p.y + a31;
+	auto ny = a12 * p.x + a22 * p.y + a32;
+	auto d = a13 * p.x + a23 * p.y + a33;
+	for (int i = 0; i < n; ++i) {
+		auto denominator = d + i * a13;
+		xs[i] = (nx + i * a11) / denominator;
+		ys[i] = (ny + i * a12) / denominator;
+	}
+}
+
+bool PerspectiveTransform::isPerspectiveIn(const QuadrilateralF& q) const
+{
+	if (!isValid())
+		return false;
+
+	// the denominator is a linear function, so it can only change its sign inside q if it does on its corners
+	int positive = 0;
+	for (auto p : q) {
+		auto denominator = a13 * p.x + a23 * p.y + a33;
+		if (denominator == 0 || std::isnan(denominator))
+			return false;
+		positive += denominator > 0;
+	}
+	return positive == 0 || positive == 4;
+}
+
 } // ZXing
@@ -41,7 +41,17 @@ public:
 	/// Project from the destination space (grid of modules) into the image space (bit matrix)
 	PointF operator()(PointF p) const;
 
+	/// Project the n points p + (i, 0) with i in [0, n) into the image space, storing the coordinates in xs and ys
+	void projectRow(PointF p, int n, value_t* xs, value_t* ys) const;
+
 	bool isValid() const { return !std::isnan(a33); }
+
+	/**
+	 * Check if this is a 'true' perspective transformation inside the (destination space) quadrilateral q, i.e. that
+	 * the denominator does not change its sign inside of q. In that case, the image of q is the convex hull of the
+	 * images of its corners.
+	 */
+	bool isPerspectiveIn(const QuadrilateralF& q) const;
 };
 
 } // ZXing
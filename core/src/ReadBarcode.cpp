@@ -10,6 +10,7 @@
 #endif
 
 #ifdef ZXING_READERS
+#include "BarcodeIndex.h"
 #include "GlobalHistogramBinarizer.h"
 #include "HybridBinarizer.h"
 #include "MultiFormatReader.h"
@@ -17,12 +18,64 @@
 #include "ThresholdBinarizer.h"
 #endif
 
+#include <algorithm>
 #include <climits>
 #include <memory>
 #include <stdexcept>
 
 namespace ZXing {
 
+// Count the alternating rises and falls of at least minContrast along a line of n pixels. Each one is measured from
+// the last extreme value, so blurry edges count just like sharp ones. Stops counting at maxCount.
+template <typename P>
+static int CountSwings(const uint8_t* p, int stride, int n, P projection, int minContrast, int maxCount)
+{
+	int lo = projection(p), hi = lo, dir = 0, count = 0;
+	for (int i = 1; i < n && count < maxCount; ++i) {
+		p += stride;
+		int v = projection(p);
+		if (dir <= 0 && v - lo >= minContrast) {
+			dir = 1, hi = v, ++count;
+		} else if (dir >= 0 && hi - v >= minContrast) {
+			dir = -1, lo = v, ++count;
+		} else {
+			lo = std::min(lo, v);
+			hi = std::max(hi, v);
+		}
+	}
+	return count;
+}
+
+bool HasPotentialBarcode(const ImageView& iv)
+{
+	// Every symbol is crossed by at least one of the rows and columns that are LINE_DIST pixels apart. Along such a
+	// line it shows at least 2 dark and 2 light modules (or bars) in front of the quiet zone, which is not the case
+	// for uniform, low contrast or blurry images. MIN_CONTRAST is the MIN_DYNAMIC_RANGE of the HybridBinarizer.
+	constexpr int LINE_DIST = 8;
+	constexpr int MIN_CONTRAST = 24;
+	constexpr int MIN_SWINGS = 4;
+
+	if (!iv.data() || iv.width() * iv.height() == 0 || iv.format() == ImageFormat::None)
+		return false;
+
+	auto hasSwings = [&](auto projection) {
+		// start in the middle of images that are only a few pixels high (or wide), e.g. single line scans
+		for (int y = std::min(LINE_DIST, iv.height()) / 2; y < iv.height(); y += LINE_DIST)
+			if (CountSwings(iv.data(0, y), iv.pixStride(), iv.width(), projection, MIN_CONTRAST, MIN_SWINGS) >= MIN_SWINGS)
+				return true;
+		for (int x = std::min(LINE_DIST, iv.width()) / 2; x < iv.width(); x += LINE_DIST)
+			if (CountSwings(iv.data(x, 0), iv.rowStride(), iv.height(), projection, MIN_CONTRAST, MIN_SWINGS) >= MIN_SWINGS)
+				return true;
+		return false;
+	};
+
+	if (iv.format() == ImageFormat::Lum || iv.format() == ImageFormat::LumA)
+		return hasSwings([](const uint8_t* src) { return int(*src); });
+	else
+		return hasSwings([r = RedIndex(iv.format()), g = GreenIndex(iv.format()), b = BlueIndex(iv.format())](
+							 const uint8_t* src) { return int(RGBToLum(src[r], src[g], src[b])); });
+}
+
 #ifdef ZXING_READERS
 
 class LumImage : public Image
@@ -152,6 +205,9 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 	if (!_iv.data() || _iv.width() * _iv.height() == 0)
 		throw std::invalid_argument("ImageView is null/empty");
 
+	if (opts.skipBlankImages() && !HasPotentialBarcode(_iv))
+		return {};
+
 	LumImage lum;
 	ImageView iv = SetupLumImageView(_iv, lum, opts);
 	MultiFormatReader reader(opts);
@@ -171,6 +227,7 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 	LumImagePyramid pyramid(iv, opts.downscaleThreshold() * opts.tryDownscale(), opts.downscaleFactor());
 
 	Barcodes res;
+	BarcodeIndex index(std::max(_iv.width(), _iv.height()));
 	int maxSymbols = opts.maxNumberOfSymbols() ? opts.maxNumberOfSymbols() : INT_MAX;
 	for (auto&& iv : pyramid.layers) {
 		auto bitmap = CreateBitmap(opts.binarizer(), iv);
@@ -190,10 +247,12 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 				for (auto& r : rs) {
 					if (iv.width() != _iv.width())
 						r.setPosition(Scale(r.position(), _iv.width() / iv.width()));
-					if (!Contains(res, r)) {
+					auto& candidates = index.candidates(r);
+					if (std::none_of(candidates.begin(), candidates.end(), [&](int i) { return res[i] == r; })) {
 						r.setReaderOptions(opts);
 						r.setIsInverted(bitmap->inverted());
 						res.push_back(std::move(r));
+						index.insert(Size(res) - 1, res.back());
 						--maxSymbols;
 					}
 				}
@@ -29,5 +29,17 @@ Barcode ReadBarcode(const ImageView& image, const ReaderOptions& options = {});
  */
 Barcodes ReadBarcodes(const ImageView& image, const ReaderOptions& options = {});
 
+/**
+ * Quick check whether an image might contain a barcode at all
+ *
+ * It samples rows and columns of the image for a minimum of contrast and structure and is a lot cheaper than a
+ * ReadBarcodes() call that finds nothing. A return value of false means the image is (close to) uniform, too low
+ * in contrast or too blurry to contain a readable symbol. See also ReaderOptions::skipBlankImages.
+ *
+ * @param image  view of the image data including layout and format
+ * @return false if the image can not contain a barcode
+ */
+bool HasPotentialBarcode(const ImageView& image);
+
 } // ZXing
 
@@ -58,6 +58,7 @@ class ReaderOptions
 	bool _validateITFCheckSum      : 1;
 	bool _returnCodabarStartEnd    : 1;
 	bool _returnErrors             : 1;
+	bool _skipBlankImages          : 1;
 	uint8_t _downscaleFactor       : 3;
 	EanAddOnSymbol _eanAddOnSymbol : 2;
 	Binarizer _binarizer           : 2;
@@ -68,7 +69,8 @@ class ReaderOptions
 #endif
 
 	uint8_t _minLineCount        = 2;
-	uint8_t _maxNumberOfSymbols  = 0xff;
+	uint8_t _maxThreads          = 0;
+	uint16_t _maxNumberOfSymbols = 0xff;
 	uint16_t _downscaleThreshold = 500;
 	BarcodeFormats _formats      = BarcodeFormat::None;
 
@@ -85,6 +87,7 @@ public:
 		  _validateITFCheckSum(0),
 		  _returnCodabarStartEnd(1),
 		  _returnErrors(0),
+		  _skipBlankImages(0),
 		  _downscaleFactor(3),
 		  _eanAddOnSymbol(EanAddOnSymbol::Ignore),
 		  _binarizer(Binarizer::LocalAverage),
@@ -138,8 +141,9 @@ public:
 	/// The number of scan lines in a linear barcode that have to be equal to accept the result, default is 2
 	ZX_PROPERTY(uint8_t, minLineCount, setMinLineCount)
 
-	/// The maximum number of symbols (barcodes) to detect / look for in the image with ReadBarcodes
-	ZX_PROPERTY(uint8_t, maxNumberOfSymbols, setMaxNumberOfSymbols)
+	/// The maximum number of symbols (barcodes) to detect / look for in the image with ReadBarcodes, 0 means no limit,
+	/// the default is 255
+	ZX_PROPERTY(uint16_t, maxNumberOfSymbols, setMaxNumberOfSymbols)
 
 	/// Enable the heuristic to detect and decode "full ASCII"/extended Code39 symbols
 	ZX_PROPERTY(bool, tryCode39ExtendedMode, setTryCode39ExtendedMode)
@@ -153,9 +157,17 @@ public:
 	/// Deprecated / does nothing. Codabar start/stop characters are always returned.
 	ZX_PROPERTY(bool, returnCodabarStartEnd, setReturnCodabarStartEnd, [[deprecated]])
 
+	/// The maximum number of threads a single ReadBarcodes call may use for the expensive scans, 0 (the default) means
+	/// std::thread::hardware_concurrency(), 1 disables multi-threading
+	ZX_PROPERTY(uint8_t, maxThreads, setMaxThreads)
+
 	/// If true, return the barcodes with errors as well (e.g. checksum errors, see @Barcode::error())
 	ZX_PROPERTY(bool, returnErrors, setReturnErrors)
 
+	/// Return early from ReadBarcodes if the image fails the HasPotentialBarcode() check, e.g. for the many empty frames
+	/// of a camera watching a conveyor belt. This costs a fraction of a full scan but may skip very low contrast symbols.
+	ZX_PROPERTY(bool, skipBlankImages, setSkipBlankImages)
+
 	/// Specify whether to ignore, read or require EAN-2/5 add-on symbols while scanning EAN/UPC codes
 	ZX_PROPERTY(EanAddOnSymbol, eanAddOnSymbol, setEanAddOnSymbol)
 
@@ -8,140 +8,201 @@
 #include "ReedSolomonDecoder.h"
 
 #include "GenericGF.h"
-#include "ZXConfig.h"
+#include "ZXAlgorithms.h"
 
 #include <algorithm>
-#include <stdexcept>
-#include <utility>
+#include <array>
+#include <vector>
 
 namespace ZXing {
 
-static bool
-RunEuclideanAlgorithm(const GenericGF& field, std::vector<int>&& rCoefs, GenericGFPoly& sigma, GenericGFPoly& omega)
-{
-	int R = Size(rCoefs); // == numECCodeWords
-	GenericGFPoly r(field, std::move(rCoefs));
-	GenericGFPoly& tLast = omega.setField(field);
-	GenericGFPoly& t = sigma.setField(field);
-	ZX_THREAD_LOCAL GenericGFPoly q, rLast;
-
-	rLast.setField(field);
-	q.setField(field);
-
-	rLast.setMonomial(1, R);
-	tLast.setMonomial(0);
-	t.setMonomial(1);
-
-	// Assume r's degree is < rLast's
-	if (r.degree() >= rLast.degree())
-		swap(r, rLast);
+// number of int buffers of size numECCodeWords + 1 used by ReedSolomonDecode()
+static constexpr int NumScratchBuffers = 6;
 
-	// Run Euclidean algorithm until r's degree is less than R/2
-	while (r.degree() >= R / 2) {
-		swap(tLast, t);
-		swap(rLast, r);
-
-		// Divide rLastLast by rLast, with quotient in q and remainder in r
-		if (rLast.isZero())
-			return false; // Oops, Euclidean algorithm already terminated?
-
-		r.divide(rLast, q);
-
-		q.multiply(tLast);
-		q.addOrSubtract(t);
-		swap(t, q); // t = q
+// avoid using the '%' modulo operator for input < 2 * ceil, see also GenericGF::multiply()
+static inline int FastMod(int input, int ceil)
+{
+	return input < ceil ? input : input - ceil;
+}
 
-		if (r.degree() >= rLast.degree())
-			throw std::runtime_error("Division algorithm failed to reduce polynomial?");
+/**
+ * Computes the numSyndromes syndromes S_i = message(a^(i + generatorBase)) of the message. The loop over the
+ * syndromes is the inner one, which makes it independent of each other and lets the compiler vectorize it.
+ * Returns true if all syndromes are 0.
+ */
+static bool ComputeSyndromes(const GenericGF& field, const std::vector<int>& message, int numSyndromes, int* syndromes,
+							 int* alphaLogs)
+{
+	const int N = field.size() - 1;
+	for (int i = 0; i < numSyndromes; ++i) {
+		syndromes[i] = 0;
+		alphaLogs[i] = (i + field.generatorBase()) % N;
 	}
 
-	int sigmaTildeAtZero = t.constant();
-	if (sigmaTildeAtZero == 0)
-		return false;
-
-	int inverse = field.inverse(sigmaTildeAtZero);
-	t.multiplyByMonomial(inverse);
-	r.multiplyByMonomial(inverse);
+	// Horner's method: S_i = (...(m_0 * a_i + m_1) * a_i + ...) + m_n-1
+	for (int c : message)
+		for (int i = 0; i < numSyndromes; ++i) {
+			int s = syndromes[i];
+			syndromes[i] = (s ? field.exp(FastMod(field.log(s) + alphaLogs[i], N)) : 0) ^ c;
+		}
 
-	// sigma is t
-	omega = std::move(r);
-	return true;
+	return std::all_of(syndromes, syndromes + numSyndromes, [](int s) { return s == 0; });
 }
 
-static std::vector<int>
-FindErrorLocations(const GenericGF& field, const GenericGFPoly& errorLocator)
+/**
+ * Berlekamp-Massey algorithm: compute the shortest LFSR (the error locator polynomial sigma, coefficients in
+ * ascending order) generating the syndrome sequence. Returns the number of errors (degree of sigma).
+ */
+static int RunBerlekampMassey(const GenericGF& field, const int* syndromes, int numSyndromes, int* sigma, int* prev,
+							  int* tmp)
 {
-	// This is a brute force search for roots of errorLocator (not Chien's search)
-	int numErrors = errorLocator.degree();
-	std::vector<int> res;
-	res.reserve(numErrors);
-
-	for (int i = 1; i < field.size() && Size(res) < numErrors; i++)
-		if (errorLocator.evaluateAt(i) == 0)
-			res.push_back(field.inverse(i));
+	std::fill_n(sigma, numSyndromes + 1, 0);
+	std::fill_n(prev, numSyndromes + 1, 0);
+	sigma[0] = prev[0] = 1;
+
+	int numErrors = 0, shift = 1, prevDiscrepancy = 1;
+	for (int k = 0; k < numSyndromes; ++k) {
+		int discrepancy = syndromes[k];
+		for (int i = 1; i <= numErrors; ++i)
+			discrepancy ^= field.multiply(sigma[i], syndromes[k - i]);
+
+		if (discrepancy == 0) {
+			++shift;
+			continue;
+		}
+
+		int factor = field.multiply(discrepancy, field.inverse(prevDiscrepancy));
+		bool lengthChange = 2 * numErrors <= k;
+		if (lengthChange)
+			std::copy_n(sigma, numSyndromes + 1, tmp);
+
+		// sigma(x) -= discrepancy / prevDiscrepancy * x^shift * prev(x)
+		for (int i = 0; i + shift <= numSyndromes; ++i)
+			sigma[i + shift] ^= field.multiply(factor, prev[i]);
+
+		if (lengthChange) {
+			numErrors = k + 1 - numErrors;
+			std::copy_n(tmp, numSyndromes + 1, prev);
+			prevDiscrepancy = discrepancy;
+			shift = 1;
+		} else {
+			++shift;
+		}
+	}
 
-	return res;
+	return numErrors;
 }
 
-static std::vector<int>
-FindErrorMagnitudes(const GenericGF& field, const GenericGFPoly& errorEvaluator, const std::vector<int>& errorLocations)
+/**
+ * Chien search: find the roots X^-1 = a^-j of sigma for all message positions j (counted from the end). Instead of
+ * evaluating sigma from scratch for each candidate, every term sigma_k * a^(-jk) is updated from the previous one
+ * with a single addition in the log domain. Returns the number of roots found, which are stored as j in locations.
+ */
+static int FindErrorLocations(const GenericGF& field, const int* sigma, int numErrors, int msgLen, int* locations,
+							  int* termLogs)
 {
-	// This is directly applying Forney's Formula
-	int s = Size(errorLocations);
-	std::vector<int> res(s);
-	for (int i = 0; i < s; ++i) {
-		int xiInverse = field.inverse(errorLocations[i]);
-		int denom = 1;
-		for (int j = 0; j < s; ++j)
-			if (i != j)
-				denom = field.multiply(denom, 1 ^ field.multiply(errorLocations[j], xiInverse));
-		res[i] = field.multiply(errorEvaluator.evaluateAt(xiInverse), field.inverse(denom));
-		if (field.generatorBase() != 0)
-			res[i] = field.multiply(res[i], xiInverse);
+	const int N = field.size() - 1;
+
+	// the log of each (non-zero) term sigma_k * a^(-jk) for the current j, -1 for zero terms
+	for (int k = 1; k <= numErrors; ++k)
+		termLogs[k] = sigma[k] ? field.log(sigma[k]) : -1;
+
+	int numFound = 0;
+	for (int j = 0; j < std::min(msgLen, N) && numFound < numErrors; ++j) {
+		int value = sigma[0];
+		for (int k = 1; k <= numErrors; ++k)
+			if (termLogs[k] >= 0) {
+				// move on from a^(-(j-1)k) to a^(-jk)
+				if (j) {
+					termLogs[k] -= k % N;
+					termLogs[k] += (termLogs[k] < 0) * N;
+				}
+				value ^= field.exp(termLogs[k]);
+			}
+		if (value == 0)
+			locations[numFound++] = j;
 	}
-	return res;
+
+	return numFound;
 }
 
 bool
 ReedSolomonDecode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
 {
-	GenericGFPoly poly(field, message);
+	const int msgLen = Size(message);
+	const int N = field.size() - 1;
+
+	if (numECCodeWords <= 0)
+		return true;
+
+	// make sure all codewords are elements of the field
+	if (std::any_of(message.begin(), message.end(), [N](int c) { return c < 0 || c > N; }))
+		return false;
 
-	std::vector<int> syndromes(numECCodeWords);
-	for (int i = 0; i < numECCodeWords; i++)
-		syndromes[numECCodeWords - 1 - i] = poly.evaluateAt(field.exp(i + field.generatorBase()));
+	// Use a fixed size buffer on the stack for all but the very large Aztec symbols
+	constexpr int MAX_STACK_EC_CODEWORDS = 256;
+	constexpr int STACK_BUFFER_SIZE = NumScratchBuffers * (MAX_STACK_EC_CODEWORDS + 1);
+	std::array<int, STACK_BUFFER_SIZE> stackBuffer;
+	std::vector<int> heapBuffer;
+	int* buffer = stackBuffer.data();
+	if (numECCodeWords > MAX_STACK_EC_CODEWORDS) {
+		heapBuffer.resize(NumScratchBuffers * (numECCodeWords + 1));
+		buffer = heapBuffer.data();
+	}
+	int* syndromes = buffer;
+	int* sigma = syndromes + (numECCodeWords + 1);
+	int* omega = sigma + (numECCodeWords + 1);
+	int* locations = omega + (numECCodeWords + 1);
+	int* tmp1 = locations + (numECCodeWords + 1);
+	int* tmp2 = tmp1 + (numECCodeWords + 1);
 
 	// if all syndromes are 0 there is no error to correct
-	if (std::all_of(syndromes.begin(), syndromes.end(), [](int c) { return c == 0; }))
+	if (ComputeSyndromes(field, message, numECCodeWords, syndromes, tmp1))
 		return true;
 
-	ZX_THREAD_LOCAL GenericGFPoly sigma, omega;
-
-	if (!RunEuclideanAlgorithm(field, std::move(syndromes), sigma, omega))
+	int numErrors = RunBerlekampMassey(field, syndromes, numECCodeWords, sigma, tmp1, tmp2);
+	if (numErrors == 0 || 2 * numErrors > numECCodeWords)
 		return false;
 
-	auto errorLocations = FindErrorLocations(field, sigma);
-	if (Size(errorLocations) != sigma.degree())
+	if (FindErrorLocations(field, sigma, numErrors, msgLen, locations, tmp1) != numErrors)
 		return false; // Error locator degree does not match number of roots, most likely there are more errors than can be recovered
 
-	auto errorMagnitudes = FindErrorMagnitudes(field, omega, errorLocations);
+	// error evaluator omega(x) = S(x) * sigma(x) mod x^numECCodeWords
+	for (int i = 0; i < numECCodeWords; ++i) {
+		omega[i] = 0;
+		for (int k = 0; k <= std::min(i, numErrors); ++k)
+			omega[i] ^= field.multiply(sigma[k], syndromes[i - k]);
+	}
 
-	int msgLen = Size(message);
-	for (int i = 0; i < Size(errorLocations); ++i) {
-		int position = msgLen - 1 - field.log(errorLocations[i]);
-		if (position < 0)
+	// Forney's Formula: e = X^(1-b) * omega(X^-1) / sigma'(X^-1)
+	for (int e = 0; e < numErrors; ++e) {
+		int j = locations[e];
+		int xInvLog = (N - j) % N;
+
+		int omegaValue = 0;
+		for (int i = numECCodeWords - 1; i >= 0; --i)
+			omegaValue = (omegaValue ? field.exp(FastMod(field.log(omegaValue) + xInvLog, N)) : 0) ^ omega[i];
+
+		// formal derivative of sigma in GF(2^m): only the odd powers remain
+		int sigmaDerivValue = 0;
+		for (int k = 1; k <= numErrors; k += 2)
+			if (sigma[k])
+				sigmaDerivValue ^= field.exp(FastMod(field.log(sigma[k]) + (k - 1) * xInvLog % N, N));
+
+		if (sigmaDerivValue == 0)
 			return false;
 
-		message[position] ^= errorMagnitudes[i];
+		int magnitude = field.multiply(omegaValue, field.inverse(sigmaDerivValue));
+		if (magnitude && field.generatorBase() != 1)
+			magnitude = field.exp(FastMod(field.log(magnitude) + (1 - field.generatorBase() + N) % N * j % N, N));
+
+		message[msgLen - 1 - j] ^= magnitude;
 	}
 
 #if 1
 	// re-evaluate the syndromes of the recovered message to make sure it is a valid (see #940)
-	poly = GenericGFPoly(field, message);
-
-	for (int i = 0; i < numECCodeWords; i++)
-		if (poly.evaluateAt(field.exp(i + field.generatorBase())) != 0)
-			return false;
+	if (!ComputeSyndromes(field, message, numECCodeWords, syndromes, tmp1))
+		return false;
 #endif
 
 	return true;
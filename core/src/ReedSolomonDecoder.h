@@ -27,6 +27,9 @@ class GenericGF;
 * (see discussion of Euclidean algorithm)</li>
 * </ul>
 *
+* <p>The error locator polynomial is computed with the Berlekamp-Massey algorithm, its roots are found with a Chien
+* search (restricted to the positions inside the message) and the error magnitudes with Forney's formula.</p>
+*
 * <p>Much credit is due to William Rucklidge since portions of this code are an indirect
 * port of his C++ Reed-Solomon implementation.</p>
 *
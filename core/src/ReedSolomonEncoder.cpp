@@ -7,32 +7,125 @@
 #include "ReedSolomonEncoder.h"
 
 #include "GenericGF.h"
+#include "ZXAlgorithms.h"
 
-#include <algorithm>
-#include <iterator>
+#include <array>
 #include <stdexcept>
 
 namespace ZXing {
 
-ReedSolomonEncoder::ReedSolomonEncoder(const GenericGF& field)
-: _field(&field)
+/**
+ * Computes the generator polynomials g_d(x) = (x - a^b)(x - a^(b+1))...(x - a^(b+d-1)) for d = 1..maxDegree one after
+ * the other. coefs is a scratch buffer of size maxDegree + 1. For each degree d, the logs of the d coefficients
+ * (highest degree first, without the leading 1, -1 for a 0 coefficient) are passed to store(d, logs).
+ */
+template <typename STORE>
+constexpr void BuildGenerators(const GenericGF& field, int maxDegree, short* coefs, short* logs, STORE store)
+{
+	coefs[0] = 1;
+	for (int d = 1; d <= maxDegree; ++d) {
+		// g_d(x) = g_d-1(x) * (x + a^(b+d-1))
+		int root = field.exp((field.generatorBase() + d - 1) % (field.size() - 1));
+		coefs[d] = 0;
+		for (int i = d; i > 0; --i)
+			coefs[i] ^= field.multiply(coefs[i - 1], root);
+
+		for (int i = 0; i < d; ++i)
+			logs[i] = coefs[i + 1] ? field.log(coefs[i + 1]) : -1;
+		store(d, logs);
+	}
+}
+
+/**
+ * The generator polynomials of all degrees up to MAX_DEGREE of a field, generated at compile-time.
+ */
+template <int MAX_DEGREE>
+struct GeneratorTable
+{
+	static constexpr int MAX = MAX_DEGREE;
+	short logs[MAX_DEGREE * (MAX_DEGREE + 1) / 2] = {};
+
+	constexpr GeneratorTable(const GenericGF& field)
+	{
+		short coefs[MAX_DEGREE + 1] = {};
+		short tmp[MAX_DEGREE] = {};
+		BuildGenerators(field, MAX_DEGREE, coefs, tmp, [this](int d, const short* l) {
+			for (int i = 0; i < d; ++i)
+				logs[d * (d - 1) / 2 + i] = l[i];
+		});
+	}
+
+	constexpr const short* operator[](int degree) const { return logs + degree * (degree - 1) / 2; }
+};
+
+// QR Code uses up to 30 ec code words per block (Micro QR Code up to 14), DataMatrix up to 68.
+static constexpr GeneratorTable<30> QR_GENERATORS(GenericGF(GF_TABLES<0x011D, 256>, 0));
+static constexpr GeneratorTable<68> DM_GENERATORS(GenericGF(GF_TABLES<0x012D, 256>, 1));
+
+// Use a fixed size buffer on the stack for all but the very large Aztec symbols
+static constexpr int MAX_STACK_EC_CODEWORDS = 512;
+
+/**
+ * Returns the logs of the coefficients of the generator polynomial of the given degree (see BuildGenerators), either
+ * from one of the precomputed tables or computed into buffer (of size 2 * degree + 1).
+ */
+static const short* GeneratorLogs(const GenericGF& field, int degree, short* buffer)
+{
+	if (&field == &GenericGF::QRCodeField256() && degree <= QR_GENERATORS.MAX)
+		return QR_GENERATORS[degree];
+	if (&field == &GenericGF::DataMatrixField256() && degree <= DM_GENERATORS.MAX)
+		return DM_GENERATORS[degree];
+
+	short* logs = buffer + degree + 1;
+	BuildGenerators(field, degree, buffer, logs, [](int, const short*) {});
+	return logs;
+}
+
+/**
+ * Linear feedback shift register style encoder: ec is the remainder of data(x) * x^numECCodeWords divided by the
+ * generator polynomial, which is updated in place for each data code word.
+ */
+template <typename T>
+static void EncodeLFSR(const GenericGF& field, const short* genLogs, const T* data, int numDataWords, T* ec,
+					   int numECCodeWords, int stride)
 {
-	_cachedGenerators.push_back(GenericGFPoly(field, { 1 }));
+	const int N = field.size() - 1;
+	auto fastMod = [N](int input) { return input < N ? input : input - N; };
+
+	for (int k = 0; k < numECCodeWords; ++k)
+		ec[k * stride] = 0;
+
+	// a^(feedbackLog + genLog) is the product of the feedback with a generator coefficient, 0 if either of them is 0
+	auto term = [&](int feedbackLog, int genLog) {
+		return feedbackLog >= 0 && genLog >= 0 ? field.exp(fastMod(feedbackLog + genLog)) : 0;
+	};
+
+	for (int i = 0; i < numDataWords; ++i) {
+		int feedback = data[i * stride] ^ ec[0];
+		int feedbackLog = feedback ? field.log(feedback) : -1;
+		for (int k = 0; k < numECCodeWords - 1; ++k)
+			ec[k * stride] = static_cast<T>(ec[(k + 1) * stride] ^ term(feedbackLog, genLogs[k]));
+		ec[(numECCodeWords - 1) * stride] = static_cast<T>(term(feedbackLog, genLogs[numECCodeWords - 1]));
+	}
 }
 
-const GenericGFPoly&
-ReedSolomonEncoder::buildGenerator(int degree)
+template <typename T>
+static void Encode(const GenericGF& field, const T* data, int numDataWords, T* ec, int numECCodeWords, int stride)
 {
-	int cachedGenSize = Size(_cachedGenerators);
-	if (degree >= cachedGenSize) {
-		GenericGFPoly lastGenerator = _cachedGenerators.back();
-		for (int d = cachedGenSize; d <= degree; d++) {
-			lastGenerator.multiply(GenericGFPoly(*_field, { 1, _field->exp(d - 1 + _field->generatorBase()) }));
-			_cachedGenerators.push_back(lastGenerator);
-		}
+	std::array<short, 2 * MAX_STACK_EC_CODEWORDS + 1> stackBuffer;
+	std::vector<short> heapBuffer;
+	short* buffer = stackBuffer.data();
+	if (numECCodeWords > MAX_STACK_EC_CODEWORDS) {
+		heapBuffer.resize(2 * numECCodeWords + 1);
+		buffer = heapBuffer.data();
 	}
 
-	return *std::next(_cachedGenerators.begin(), degree);
+	EncodeLFSR(field, GeneratorLogs(field, numECCodeWords, buffer), data, numDataWords, ec, numECCodeWords, stride);
+}
+
+ReedSolomonEncoder::ReedSolomonEncoder(const GenericGF& field)
+: _field(&field)
+{
 }
 
 void
@@ -41,14 +134,22 @@ ReedSolomonEncoder::encode(std::vector<int>& message, const int numECCodeWords)
 	if (numECCodeWords == 0 || numECCodeWords >= Size(message))
 		throw std::invalid_argument("Invalid number of error correction code words");
 
-	GenericGFPoly info = GenericGFPoly(*_field, std::vector<int>(message.begin(), message.end() - numECCodeWords));
-	info.multiplyByMonomial(1, numECCodeWords);
-	GenericGFPoly _;
-	info.divide(buildGenerator(numECCodeWords), _);
-	auto& coefficients = info.coefficients();
-	int numZeroCoefficients = numECCodeWords - Size(coefficients);
-	std::fill_n(message.end() - numECCodeWords, numZeroCoefficients, 0);
-	std::copy(coefficients.begin(), coefficients.end(), message.end() - numECCodeWords + numZeroCoefficients);
+	int numDataWords = Size(message) - numECCodeWords;
+	Encode(*_field, message.data(), numDataWords, message.data() + numDataWords, numECCodeWords, 1);
+}
+
+void ReedSolomonEncode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
+{
+	ReedSolomonEncoder(field).encode(message, numECCodeWords);
+}
+
+void ReedSolomonEncode(const GenericGF& field, const uint8_t* data, int numDataWords, uint8_t* ec, int numECCodeWords,
+					   int stride)
+{
+	if (field.size() > 256 || numECCodeWords <= 0)
+		throw std::invalid_argument("Invalid field or number of error correction code words");
+
+	Encode(field, data, numDataWords, ec, numECCodeWords, stride);
 }
 
 } // ZXing
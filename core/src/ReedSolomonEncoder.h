@@ -6,13 +6,13 @@
 
 #pragma once
 
-#include "GenericGFPoly.h"
-
-#include <list>
+#include <cstdint>
 #include <vector>
 
 namespace ZXing {
 
+class GenericGF;
+
 // public only for testing purposes
 class ReedSolomonEncoder
 {
@@ -23,17 +23,21 @@ public:
 
 private:
 	const GenericGF* _field;
-	std::list<GenericGFPoly> _cachedGenerators;
-
-	const GenericGFPoly& buildGenerator(int degree);
 };
 
 /**
  * @brief ReedSolomonEncode replaces the last numECCodeWords code words in message with error correction code words
  */
-inline void ReedSolomonEncode(const GenericGF& field, std::vector<int>& message, int numECCodeWords)
-{
-	ReedSolomonEncoder(field).encode(message, numECCodeWords);
-}
+void ReedSolomonEncode(const GenericGF& field, std::vector<int>& message, int numECCodeWords);
+
+/**
+ * @brief ReedSolomonEncode computes the numECCodeWords error correction code words for the numDataWords data code words
+ * of a code over a field with at most 256 elements, without any heap allocation.
+ *
+ * The code words of one block may be interleaved with those of other blocks: data[i * stride] is the i-th data
+ * code word and the i-th error correction code word is written to ec[i * stride].
+ */
+void ReedSolomonEncode(const GenericGF& field, const uint8_t* data, int numDataWords, uint8_t* ec, int numECCodeWords,
+					   int stride = 1);
 
 } // namespace ZXing
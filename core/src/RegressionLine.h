@@ -22,6 +22,7 @@ class RegressionLine
 {
 protected:
 	std::vector<PointF> _points;
+	std::vector<PointF> _filtered; // scratch buffer of evaluate(), kept here to reuse its memory
 	PointF _directionInward;
 	PointF::value_t a = NAN, b = NAN, c = NAN;
 
@@ -63,7 +64,8 @@ public:
 
 	template<typename T> RegressionLine(PointT<T> a, PointT<T> b)
 	{
-		evaluate(std::vector{a, b});
+		PointT<T> points[] = {a, b};
+		evaluate(std::begin(points), std::end(points));
 	}
 
 	template<typename T> RegressionLine(const PointT<T>* b, const PointT<T>* e)
@@ -107,7 +109,8 @@ public:
 	{
 		bool ret = evaluate(_points);
 		if (maxSignedDist > 0) {
-			auto points = _points;
+			auto& points = _filtered;
+			points.assign(_points.begin(), _points.end());
 			while (true) {
 				auto old_points_size = points.size();
 				// remove points that are further 'inside' than maxSignedDist or further 'outside' than 2 x maxSignedDist
@@ -136,7 +139,7 @@ public:
 			}
 
 			if (updatePoints)
-				_points = std::move(points);
+				std::swap(_points, points);
 		}
 		return ret;
 	}
@@ -10,11 +10,32 @@
 #include "ZXAlgorithms.h"
 #include "libzueci/zueci.h"
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
 namespace ZXing {
 
+// Latin-1 (and binary data) maps each byte to the code point of the same value, i.e. to 1 or 2 UTF-8 bytes
+static std::string Latin1ToUtf8(ByteView bytes)
+{
+	int highCount = 0;
+	for (auto b : bytes)
+		highCount += b >> 7;
+
+	std::string utf8(bytes.size() + highCount, 0);
+	auto* out = utf8.data();
+	for (auto b : bytes) {
+		if (b < 0x80) {
+			*out++ = b;
+		} else {
+			*out++ = narrow_cast<char>(0xC0 | (b >> 6));
+			*out++ = narrow_cast<char>(0x80 | (b & 0x3F));
+		}
+	}
+	return utf8;
+}
+
 std::string BytesToUtf8(ByteView bytes, ECI eci)
 {
 	constexpr unsigned int replacement = 0xFFFD;
@@ -24,6 +45,12 @@ std::string BytesToUtf8(ByteView bytes, ECI eci)
 	if (eci == ECI::Unknown)
 		eci = ECI::Binary;
 
+	// the by far most common encodings don't need the two passes of zueci (length query and conversion)
+	if (IsAsciiCompatible(eci) && IsAscii(bytes))
+		return std::string(bytes.begin(), bytes.end());
+	if (eci == ECI::ISO8859_1 || eci == ECI::Binary)
+		return Latin1ToUtf8(bytes);
+
 	int error_number = zueci_dest_len_utf8(ToInt(eci), bytes.data(), bytes.size(), replacement, flags, &utf8_len);
 	if (error_number >= ZUECI_ERROR)
 		throw std::runtime_error("zueci_dest_len_utf8 failed");
@@ -70,6 +97,14 @@ CharacterSet GuessTextEncoding(ByteView bytes, CharacterSet fallback)
 	//int isoHighChars = 0;
 	int isoHighOther = 0;
 
+	bool assumeShiftJIS = fallback == CharacterSet::Shift_JIS || fallback == CharacterSet::EUC_JP;
+
+	// shortcut for the most common case of pure ASCII content, same result as the analysis below
+	if (!bytes.empty() && IsAscii(bytes)) {
+		bool isBinary = std::any_of(bytes.begin(), bytes.end(), [](uint8_t b) { return b < 0x20 && b != 0xa && b != 0xd; });
+		return assumeShiftJIS && !isBinary ? CharacterSet::Shift_JIS : CharacterSet::ISO8859_1;
+	}
+
 	bool utf8bom = bytes.size() > 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF;
 
 	for (int value : bytes)
@@ -186,7 +221,6 @@ CharacterSet GuessTextEncoding(ByteView bytes, CharacterSet fallback)
 		return CharacterSet::UTF8;
 	}
 
-	bool assumeShiftJIS = fallback == CharacterSet::Shift_JIS || fallback == CharacterSet::EUC_JP;
 	// Easy -- if assuming Shift_JIS or at least 3 valid consecutive not-ascii characters (and no evidence it can't be), done
 	if (canBeShiftJIS && (assumeShiftJIS || sjisMaxKatakanaWordLength >= 3 || sjisMaxDoubleBytesWordLength >= 3)) {
 		return CharacterSet::Shift_JIS;
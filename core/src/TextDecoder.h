@@ -13,6 +13,17 @@
 
 namespace ZXing {
 
+/**
+ * @brief IsAscii checks if all bytes are < 0x80, written to be auto-vectorized
+ */
+inline bool IsAscii(ByteView bytes)
+{
+	uint8_t res = 0;
+	for (auto b : bytes)
+		res |= b;
+	return res < 0x80;
+}
+
 std::string BytesToUtf8(ByteView bytes, ECI eci);
 
 inline std::string BytesToUtf8(ByteView bytes, CharacterSet cs)
@@ -27,7 +27,7 @@ namespace ZXing {
 
 using state_t = uint8_t;
 constexpr state_t kAccepted = 0;
-constexpr state_t kRejected [[maybe_unused]] = 12;
+constexpr state_t kRejected = 12;
 
 inline char32_t Utf8Decode(char8_t byte, state_t& state, char32_t& codep)
 {
@@ -60,6 +60,16 @@ inline char32_t Utf8Decode(char8_t byte, state_t& state, char32_t& codep)
 	return state;
 }
 
+bool IsValidUtf8(std::string_view utf8)
+{
+	char32_t codePoint = 0;
+	state_t state = kAccepted;
+	for (auto b : utf8)
+		if (Utf8Decode(b, state, codePoint) == kRejected)
+			return false;
+	return state == kAccepted;
+}
+
 static_assert(sizeof(wchar_t) == 4 || sizeof(wchar_t) == 2, "wchar_t needs to be 2 or 4 bytes wide");
 
 inline bool IsUtf16SurrogatePair(std::wstring_view str)
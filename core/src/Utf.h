@@ -16,6 +16,8 @@ std::wstring FromUtf8(std::string_view utf8);
 std::wstring FromUtf8(std::u8string_view utf8);
 #endif
 
+bool IsValidUtf8(std::string_view utf8);
+
 std::wstring EscapeNonGraphical(std::wstring_view str);
 std::string EscapeNonGraphical(std::string_view utf8);
 
@@ -286,8 +286,10 @@ ZX_PROPERTY(bool, tryDownscale, TryDownscale)
 #endif
 ZX_PROPERTY(bool, isPure, IsPure)
 ZX_PROPERTY(bool, returnErrors, ReturnErrors)
+ZX_PROPERTY(bool, skipBlankImages, SkipBlankImages)
 ZX_PROPERTY(int, minLineCount, MinLineCount)
 ZX_PROPERTY(int, maxNumberOfSymbols, MaxNumberOfSymbols)
+ZX_PROPERTY(int, maxThreads, MaxThreads)
 
 #undef ZX_PROPERTY
 
@@ -155,7 +155,7 @@ static std::pair<BitArray, int> CorrectBits(const DetectorResult& ddata, const B
 
 	// Now perform the unstuffing operation.
 	BitArray correctedBits;
-	// correctedBits.reserve(numDataCodewords * codewordSize - stuffedBits);
+	correctedBits.reserve(numDataCodewords * codewordSize);
 	for (int dataWord : dataWords) {
 		if (dataWord == 0 || dataWord == (1 << codewordSize) - 1)
 			return {};
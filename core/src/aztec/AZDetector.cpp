@@ -12,6 +12,7 @@
 #include "BitHacks.h"
 #include "BitMatrix.h"
 #include "ConcentricFinder.h"
+#include "ConcentricScan.h"
 #include "GenericGF.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
@@ -125,6 +126,56 @@ static std::vector<ConcentricPattern> FindPureFinderPattern(const BitMatrix& ima
 		return {};
 }
 
+// Search one row for center patterns and append them to res
+static void FindFinderPatternsInRow(const BitMatrix& image, int y, const PatternRow& row, std::vector<ConcentricPattern>& res)
+{
+	PatternView next = row;
+	next.shift(1); // the center pattern we are looking for starts with white and is 7 wide (compact code)
+
+#if 1
+	while (next = FindAztecCenterPattern(next), next.isValid()) {
+#else
+	constexpr auto PATTERN = FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1};
+	while (next = FindLeftGuard(next, 0, PATTERN, 0.5), next.isValid()) {
+#endif
+		PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] + next[3] / 2.0, y + 0.5);
+
+		// make sure p is not 'inside' an already found pattern area
+		bool found = false;
+		for (auto old = res.rbegin(); old != res.rend(); ++old) {
+			// search from back to front, stop once we are out of range due to the y-coordinate
+			if (p.y - old->y > old->size / 2)
+				break;
+			if (distance(p, *old) < old->size / 2) {
+				found = true;
+				break;
+			}
+		}
+
+		if (!found) {
+			log(p, 1);
+
+			auto pattern = LocateAztecCenter(image, p, next.sum());
+			if (pattern) {
+				log(*pattern, 3);
+				assert(image.get(*pattern));
+				res.push_back(*pattern);
+			}
+		}
+
+		next.skipPair();
+		next.extend();
+	}
+}
+
+ConcentricRowScan FinderPatternRowScan(const BitMatrix& image, bool tryHarder)
+{
+	int skip = tryHarder ? 1 : std::clamp(image.height() / 2 / 100, 1, 5);
+	int margin = tryHarder ? 5 : image.height() / 4;
+
+	return {margin, image.height() - margin, skip, FindFinderPatternsInRow};
+}
+
 static std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
 {
 	std::vector<ConcentricPattern> res;
@@ -179,53 +230,7 @@ static std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image,
 		}
 	}
 #else // own algorithm based on PatternRow processing (between 0% and 100% faster than reference algo depending on input)
-	int skip = tryHarder ? 1 : std::clamp(image.height() / 2 / 100, 1, 5);
-	int margin = tryHarder ? 5 : image.height() / 4;
-
-	PatternRow row;
-
-	for (int y = margin; y < image.height() - margin; y += skip)
-	{
-		GetPatternRow(image, y, row, false);
-		PatternView next = row;
-		next.shift(1); // the center pattern we are looking for starts with white and is 7 wide (compact code)
-
-#if 1
-		while (next = FindAztecCenterPattern(next), next.isValid()) {
-#else
-		constexpr auto PATTERN = FixedPattern<7, 7>{1, 1, 1, 1, 1, 1, 1};
-		while (next = FindLeftGuard(next, 0, PATTERN, 0.5), next.isValid()) {
-#endif
-			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] + next[3] / 2.0, y + 0.5);
-
-			// make sure p is not 'inside' an already found pattern area
-			bool found = false;
-			for (auto old = res.rbegin(); old != res.rend(); ++old) {
-				// search from back to front, stop once we are out of range due to the y-coordinate
-				if (p.y - old->y > old->size / 2)
-					break;
-				if (distance(p, *old) < old->size / 2) {
-					found = true;
-					break;
-				}
-			}
-
-			if (!found) {
-				++N;
-				log(p, 1);
-
-				auto pattern = LocateAztecCenter(image, p, next.sum());
-				if (pattern) {
-					log(*pattern, 3);
-					assert(image.get(*pattern));
-					res.push_back(*pattern);
-				}
-			}
-
-			next.skipPair();
-			next.extend();
-		}
-	}
+	res = std::move(ScanRowsForConcentricPatterns(image, {FinderPatternRowScan(image, tryHarder)}).front());
 #endif
 
 #ifdef PRINT_DEBUG
@@ -354,8 +359,12 @@ DetectorResults Detect(const BitMatrix& image, bool isPure, bool tryHarder, int
 	LogMatrixWriter lmw(log, image, 5, "az-log.pnm");
 #endif
 
+	return Detect(image, isPure ? FindPureFinderPattern(image) : FindFinderPatterns(image, tryHarder), maxSymbols);
+}
+
+DetectorResults Detect(const BitMatrix& image, const std::vector<ConcentricPattern>& fps, int maxSymbols)
+{
 	DetectorResults res;
-	auto fps = isPure ? FindPureFinderPattern(image) : FindFinderPatterns(image, tryHarder);
 	for (const auto& fp : fps) {
 		auto fpQuad = FindConcentricPatternCorners(image, fp, fp.size, 3);
 		if (!fpQuad)
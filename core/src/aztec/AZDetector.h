@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "ConcentricScan.h"
+
 #include <vector>
 
 namespace ZXing {
@@ -20,6 +22,9 @@ DetectorResult Detect(const BitMatrix& image, bool isPure, bool tryHarder = true
 
 using DetectorResults = std::vector<DetectorResult>;
 DetectorResults Detect(const BitMatrix& image, bool isPure, bool tryHarder, int maxSymbols);
+DetectorResults Detect(const BitMatrix& image, const std::vector<ConcentricPattern>& fps, int maxSymbols);
+
+ConcentricRowScan FinderPatternRowScan(const BitMatrix& image, bool tryHarder);
 
 } // Aztec
 } // ZXing
@@ -140,13 +140,11 @@ void StuffBits(const BitArray& bits, int wordSize, BitArray& out)
 	out = BitArray();
 	int n = bits.size();
 	int mask = (1 << wordSize) - 2;
+	out.reserve(n + n / (wordSize - 1) + wordSize);
 	for (int i = 0; i < n; i += wordSize) {
-		int word = 0;
-		for (int j = 0; j < wordSize; j++) {
-			if (i + j >= n || bits.get(i + j)) {
-				word |= 1 << (wordSize - 1 - j);
-			}
-		}
+		// a word crossing the end of bits is padded with 1s
+		int numBits = std::min(wordSize, n - i);
+		int word = (ToInt(bits, i, numBits) << (wordSize - numBits)) | ((1 << (wordSize - numBits)) - 1);
 		if ((word & mask) == mask) {
 			out.appendBits(word & mask, wordSize);
 			i--;
@@ -11,6 +11,7 @@
 #include "AZDetector.h"
 #include "AZDetectorResult.h"
 #include "BinaryBitmap.h"
+#include "ConcentricScan.h"
 #include "ReaderOptions.h"
 #include "DecoderResult.h"
 #include "Barcode.h"
@@ -30,7 +31,8 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	if (binImg == nullptr)
 		return {};
 	
-	auto detRess = Detect(*binImg, _opts.isPure(), _opts.tryHarder(), maxSymbols);
+	auto detRess = _opts.isPure() ? Detect(*binImg, true, _opts.tryHarder(), maxSymbols)
+								  : Detect(*binImg, FindConcentricPatterns(image, BarcodeFormat::Aztec, _opts), maxSymbols);
 
 	Barcodes res;
 	for (auto&& detRes : detRess) {
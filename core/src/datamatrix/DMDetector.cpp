@@ -7,9 +7,10 @@
 
 #include "DMDetector.h"
 
+#include "BinaryBitmap.h"
 #include "BitMatrix.h"
 #include "BitMatrixCursor.h"
-#include "ByteMatrix.h"
+#include "DMTraceHistory.h"
 #include "DetectorResult.h"
 #include "GridSampler.h"
 #include "LogMatrix.h"
@@ -24,7 +25,10 @@
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <future>
 #include <map>
+#include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -412,6 +416,9 @@ static DetectorResult DetectOld(const BitMatrix& image)
 
 class DMRegressionLine : public RegressionLine
 {
+	// scratch buffers of modules(), kept here to reuse their memory from one call to the next
+	std::vector<double> _gapSizes, _modSizes;
+
 	template <typename Container, typename Filter>
 	static double average(const Container& c, Filter f)
 	{
@@ -435,8 +442,10 @@ public:
 		// re-evaluate and filter out all points too far away. required for the gapSizes calculation.
 		evaluate(1.2, true);
 
-		std::vector<double> gapSizes, modSizes;
-		gapSizes.reserve(_points.size());
+		auto& gapSizes = _gapSizes;
+		auto& modSizes = _modSizes;
+		gapSizes.clear();
+		modSizes.clear();
 
 		// calculate the distance between the points projected onto the regression line
 		for (size_t i = 1; i < _points.size(); ++i)
@@ -565,7 +574,7 @@ class EdgeTracer : public BitMatrixCursorF
 	}
 
 public:
-	ByteMatrix* history = nullptr;
+	TraceHistory* history = nullptr;
 	int state = 0;
 
 	using BitMatrixCursorF::BitMatrixCursor;
@@ -858,65 +867,157 @@ static DetectorResult Scan(EdgeTracer& startTracer, std::array<DMRegressionLine,
 	return {};
 }
 
-static DetectorResults DetectNew(const BitMatrix& image, bool tryHarder, bool tryRotate)
+/**
+* The multi-line scan of the 'new' detector as a state machine: next() returns the next symbol found by Scan() or an
+* invalid result once all scan lines are done. Each scan direction starts from one side of the image, going towards
+* the center. Only the center line is scanned unless tryHarder is set, in which case parallel lines to both sides of
+* the center follow. The directions are independent of each other and can be scanned by separate threads. Lines that
+* the ContrastMap marks as flat are skipped, as there is no edge to start tracing from.
+*/
+class MultiLineScanner
 {
-#ifdef PRINT_DEBUG
-	LogMatrixWriter lmw(log, image, 1, "dm-log.pnm");
-//	tryRotate = tryHarder = false;
-#endif
+	static constexpr int MIN_SYMBOL_SIZE = 8 * 2; // minimum realistic size in pixel: 8 modules x 2 pixels per module
+	static constexpr std::array<PointF, 4> DIRECTIONS = {PointF{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
 
-	// disable expensive multi-line scan to detect off-center symbols for now
-#ifndef __cpp_impl_coroutine
-	tryHarder = false;
-#endif
+	const BitMatrix& _image;
+	const ContrastMap* _contrast;
+	bool _tryHarder;
+	int _dir, _dirEnd;
+	int _line = 0;
+	std::optional<EdgeTracer> _tracer; // set while the current line has not been scanned to the end
 
 	// a history log to remember where the tracing already passed by to prevent a later trace from doing the same work twice
-	ByteMatrix history;
-	if (tryHarder)
-		history = ByteMatrix(image.width(), image.height());
-
+	TraceHistory _history;
 	// instantiate RegressionLine objects outside of Scan function to prevent repetitive std::vector allocations
-	std::array<DMRegressionLine, 4> lines;
-
-	constexpr int minSymbolSize = 8 * 2; // minimum realistic size in pixel: 8 modules x 2 pixels per module
-
-	for (auto dir : {PointF{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
-		auto center = PointI(image.width() / 2, image.height() / 2);
-		auto startPos = centered(center - center * dir + minSymbolSize / 2 * dir);
+	std::array<DMRegressionLine, 4> _lines;
 
-		history.clear();
+public:
+	MultiLineScanner(const BitMatrix& image, const ContrastMap* contrast, bool tryHarder, int firstDir, int lastDir)
+		: _image(image), _contrast(contrast), _tryHarder(tryHarder), _dir(firstDir), _dirEnd(lastDir + 1)
+	{
+		if (tryHarder)
+			_history = TraceHistory(image.width(), image.height());
+	}
 
-		for (int i = 1;; ++i) {
-			EdgeTracer tracer(image, startPos, dir);
-			tracer.p += i / 2 * minSymbolSize * (i & 1 ? -1 : 1) * tracer.right();
-			if (tryHarder)
-				tracer.history = &history;
+	DetectorResult next()
+	{
+		while (_dir < _dirEnd) {
+			if (!_tracer) {
+				if (_line++ == 0)
+					_history.clear();
+
+				auto dir = DIRECTIONS[_dir];
+				auto center = PointI(_image.width() / 2, _image.height() / 2);
+				auto startPos = centered(center - center * dir + MIN_SYMBOL_SIZE / 2 * dir);
+
+				_tracer.emplace(_image, startPos, dir);
+				_tracer->p += _line / 2 * MIN_SYMBOL_SIZE * (_line & 1 ? -1 : 1) * _tracer->right();
+				if (_tryHarder)
+					_tracer->history = &_history;
+
+				if (!_tracer->isIn()) {
+					nextDirection();
+					continue;
+				}
 
-			if (!tracer.isIn())
-				break;
+				if (isFlat(*_tracer)) {
+					_tracer.reset();
+					if (!_tryHarder)
+						nextDirection();
+					continue;
+				}
+			}
 
-#ifdef __cpp_impl_coroutine
-			DetectorResult res;
-			while (res = Scan(tracer, lines), res.isValid())
-				co_yield std::move(res);
-#else
-			if (auto res = Scan(tracer, lines); res.isValid())
+			if (auto res = Scan(*_tracer, _lines); res.isValid())
 				return res;
-#endif
 
-			if (!tryHarder)
-				break; // only test center lines
+			_tracer.reset();
+			if (!_tryHarder)
+				nextDirection(); // only test center lines
 		}
 
-		if (!tryRotate)
-			break; // only test left direction
+		return {};
+	}
+
+private:
+	bool isFlat(const EdgeTracer& t) const
+	{
+		if (!_contrast)
+			return false;
+		auto p = PointI(t.p);
+		return t.d.y == 0 ? _contrast->flatRows[p.y] : _contrast->flatCols[p.x];
 	}
 
-#ifndef __cpp_impl_coroutine
-	return {};
-#endif
+	void nextDirection()
+	{
+		++_dir;
+		_line = 0;
+		_tracer.reset();
+	}
+};
+
+/**
+* Scan the four directions on separate threads and return all results in the same order as the sequential
+* MultiLineScanner(image, tryHarder, 0, 3) would.
+*/
+static std::vector<DetectorResult> ScanAllDirectionsInParallel(const BitMatrix& image, const ContrastMap* contrast, bool tryHarder)
+{
+	auto scan = [&image, contrast, tryHarder](int dir) {
+		std::vector<DetectorResult> res;
+		MultiLineScanner scanner(image, contrast, tryHarder, dir, dir);
+		for (auto r = scanner.next(); r.isValid(); r = scanner.next())
+			res.push_back(std::move(r));
+		return res;
+	};
+
+	std::array<std::future<std::vector<DetectorResult>>, 3> futures;
+	for (int dir = 1; dir < 4; ++dir)
+		futures[dir - 1] = std::async(std::launch::async, scan, dir);
+
+	auto res = scan(0);
+	for (auto& f : futures) {
+		auto r = f.get();
+		res.insert(res.end(), std::move_iterator(r.begin()), std::move_iterator(r.end()));
+	}
+	return res;
 }
 
+/**
+* Returns the results of the multi-line scan one after the other, see MultiLineScanner. If the expensive tryHarder and
+* tryRotate scan was requested and allowed to run in parallel, all results are computed up front.
+*/
+class DetectNew
+{
+	std::optional<MultiLineScanner> _scanner;
+	std::vector<DetectorResult> _results;
+	size_t _next = 0;
+#ifdef PRINT_DEBUG
+	LogMatrixWriter _lmw;
+#endif
+
+public:
+	DetectNew(const BitMatrix& image, const ContrastMap* contrast, bool tryHarder, bool tryRotate, bool parallel)
+#ifdef PRINT_DEBUG
+		: _lmw(log, image, 1, "dm-log.pnm")
+#endif
+	{
+#ifdef PRINT_DEBUG
+		parallel = false; // the LogMatrix is not thread safe
+#endif
+		if (parallel && tryHarder && tryRotate && std::thread::hardware_concurrency() > 1)
+			_results = ScanAllDirectionsInParallel(image, contrast, tryHarder);
+		else
+			_scanner.emplace(image, contrast, tryHarder, 0, tryRotate ? 3 : 0);
+	}
+
+	DetectorResult next()
+	{
+		if (_scanner)
+			return _scanner->next();
+		return _next < _results.size() ? std::move(_results[_next++]) : DetectorResult();
+	}
+};
+
 /**
 * This method detects a code in a "pure" image -- that is, pure monochrome image
 * which contains only an unrotated, unskewed, image of a code, with some optional white border
@@ -957,16 +1058,18 @@ static DetectorResult DetectPure(const BitMatrix& image)
 			{{left, top}, {right, top}, {right, bottom}, {left, bottom}}};
 }
 
-DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure)
-{
 #ifdef __cpp_impl_coroutine
+DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure, bool parallel,
+					   const ContrastMap* contrast)
+{
 	// First try the very fast DetectPure() path. Also because DetectNew() generally fails with pure module size 1 symbols
 	// TODO: implement a tryRotate version of DetectPure, see #590.
 	if (auto r = DetectPure(image); r.isValid())
 		co_yield std::move(r);
 	else if (!isPure) { // If r.isValid() then there is no point in looking for more (no-pure) symbols
 		bool found = false;
-		for (auto&& r : DetectNew(image, tryHarder, tryRotate)) {
+		DetectNew detectNew(image, contrast, tryHarder, tryRotate, parallel);
+		for (auto r = detectNew.next(); r.isValid(); r = detectNew.next()) {
 			found = true;
 			co_yield std::move(r);
 		}
@@ -975,14 +1078,76 @@ DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, b
 				co_yield std::move(r);
 		}
 	}
+}
 #else
-	auto result = DetectPure(image);
-	if (!result.isValid() && !isPure)
-		result = DetectNew(image, tryHarder, tryRotate);
-	if (!result.isValid() && tryHarder && !isPure)
-		result = DetectOld(image);
-	return result;
-#endif
+/**
+* The state machine equivalent of the coroutine version of Detect() above.
+*/
+struct DetectorResults::State
+{
+	enum class Stage { Pure, New, Old, Done };
+
+	const BitMatrix& image;
+	const ContrastMap* contrast;
+	bool tryHarder, tryRotate, isPure, parallel;
+	Stage stage = Stage::Pure;
+	bool found = false;
+	std::optional<DetectNew> detectNew;
+
+	State(const BitMatrix& image, const ContrastMap* contrast, bool tryHarder, bool tryRotate, bool isPure, bool parallel)
+		: image(image), contrast(contrast), tryHarder(tryHarder), tryRotate(tryRotate), isPure(isPure), parallel(parallel)
+	{}
+
+	DetectorResult next()
+	{
+		switch (stage) {
+		case Stage::Pure:
+			// First try the very fast DetectPure() path. Also because DetectNew() generally fails with pure module size 1
+			// symbols. If that is successful, there is no point in looking for more (no-pure) symbols.
+			stage = isPure ? Stage::Done : Stage::New;
+			if (auto r = DetectPure(image); r.isValid()) {
+				stage = Stage::Done;
+				return r;
+			}
+			return next();
+		case Stage::New:
+			if (!detectNew)
+				detectNew.emplace(image, contrast, tryHarder, tryRotate, parallel);
+			if (auto r = detectNew->next(); r.isValid()) {
+				found = true;
+				return r;
+			}
+			detectNew.reset();
+			stage = !found && tryHarder ? Stage::Old : Stage::Done;
+			return next();
+		case Stage::Old: stage = Stage::Done; return DetectOld(image);
+		case Stage::Done: break;
+		}
+		return {};
+	}
+};
+
+DetectorResults::DetectorResults(std::unique_ptr<State>&& state) : _state(std::move(state)) {}
+DetectorResults::DetectorResults(DetectorResults&&) noexcept = default;
+DetectorResults::~DetectorResults() = default;
+
+void DetectorResults::Iter::operator++()
+{
+	_current = _state->next();
+}
+
+DetectorResults::Iter DetectorResults::begin()
+{
+	Iter res(_state.get());
+	++res;
+	return res;
 }
 
+DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure, bool parallel,
+					   const ContrastMap* contrast)
+{
+	return DetectorResults(std::make_unique<DetectorResults::State>(image, contrast, tryHarder, tryRotate, isPure, parallel));
+}
+#endif
+
 } // namespace ZXing::DataMatrix
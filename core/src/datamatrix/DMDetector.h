@@ -6,25 +6,66 @@
 
 #pragma once
 
+#include <DetectorResult.h>
+
 #ifdef __cpp_impl_coroutine
 #include <Generator.h>
-#include <DetectorResult.h>
+#else
+#include <memory>
 #endif
 
 namespace ZXing {
 
 class BitMatrix;
-class DetectorResult;
+struct ContrastMap;
 
 namespace DataMatrix {
 
 #ifdef __cpp_impl_coroutine
 using DetectorResults = Generator<DetectorResult>;
 #else
-using DetectorResults = DetectorResult;
+/**
+* Without coroutine support, the detected symbols are produced one after the other by a state machine. This class
+* provides the same range-based for loop support as the Generator.
+*/
+class DetectorResults
+{
+public:
+	struct State;
+
+	class Iter
+	{
+		State* _state;
+		DetectorResult _current;
+
+	public:
+		explicit Iter(State* state) : _state(state) {}
+
+		void operator++();
+		DetectorResult&& operator*() { return std::move(_current); }
+		bool operator!=(const Iter&) const { return _current.isValid(); }
+	};
+
+	explicit DetectorResults(std::unique_ptr<State>&& state);
+	DetectorResults(DetectorResults&&) noexcept;
+	~DetectorResults();
+
+	Iter begin();
+	Iter end() { return Iter(nullptr); }
+
+private:
+	std::unique_ptr<State> _state;
+};
 #endif
 
-DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure);
+/**
+* @param parallel allow the expensive tryHarder and tryRotate scan to use 3 threads (ignored on single core machines).
+* The results are the same but are all computed before the first one is returned. So this is only useful if more than
+* one symbol is requested.
+* @param contrast if given, the scan lines it marks as flat are skipped
+*/
+DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, bool isPure, bool parallel = false,
+					   const ContrastMap* contrast = nullptr);
 
 } // DataMatrix
 } // ZXing
@@ -6,6 +6,7 @@
 
 #include "DMReader.h"
 
+#include "BarcodeIndex.h"
 #include "BinaryBitmap.h"
 #include "DMDecoder.h"
 #include "DMDetector.h"
@@ -14,28 +15,16 @@
 #include "DetectorResult.h"
 #include "Barcode.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace ZXing::DataMatrix {
 
 Barcode Reader::decode(const BinaryBitmap& image) const
 {
-#ifdef __cpp_impl_coroutine
 	return FirstOrDefault(decode(image, 1));
-#else
-	auto binImg = image.getBitMatrix();
-	if (binImg == nullptr)
-		return {};
-	
-	auto detectorResult = Detect(*binImg, _opts.tryHarder(), _opts.tryRotate(), _opts.isPure());
-	if (!detectorResult.isValid())
-		return {};
-
-	return Barcode(Decode(detectorResult.bits()), std::move(detectorResult), BarcodeFormat::DataMatrix);
-#endif
 }
 
-#ifdef __cpp_impl_coroutine
 Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
 	auto binImg = image.getBitMatrix();
@@ -43,10 +32,27 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 		return {};
 
 	Barcodes res;
-	for (auto&& detRes : Detect(*binImg, _opts.tryHarder(), _opts.tryRotate(), _opts.isPure())) {
+	BarcodeIndex index(std::max(binImg->width(), binImg->height()));
+	// the multi-line scan finds most symbols more than once (e.g. once per scan direction), there is no need to decode
+	// a symbol again if the center of the detected one is inside a successfully decoded one
+	auto isKnown = [&](const DetectorResult& detRes) {
+		auto center = Center(detRes.position());
+		for (int i : index.candidates(detRes.position(), BarcodeFormat::DataMatrix))
+			if (res[i].isValid() && IsInside(center, res[i].position()))
+				return true;
+		return false;
+	};
+
+	// scanning in parallel computes all results up front, which is wasted effort if only the first symbol is requested.
+	// It uses 3 threads, so it is only done if the user allows that many.
+	bool parallel = maxSymbols != 1 && (_opts.maxThreads() == 0 || _opts.maxThreads() >= 3);
+	for (auto&& detRes : Detect(*binImg, _opts.tryHarder(), _opts.tryRotate(), _opts.isPure(), parallel, image.contrastMap())) {
+		if (isKnown(detRes))
+			continue;
 		auto decRes = Decode(detRes.bits());
 		if (decRes.isValid(_opts.returnErrors())) {
 			res.emplace_back(std::move(decRes), std::move(detRes), BarcodeFormat::DataMatrix);
+			index.insert(Size(res) - 1, res.back());
 			if (maxSymbols > 0 && Size(res) >= maxSymbols)
 				break;
 		}
@@ -54,5 +60,5 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 
 	return res;
 }
-#endif
+
 } // namespace ZXing::DataMatrix
@@ -0,0 +1,73 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Point.h"
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ZXing::DataMatrix {
+
+/**
+* A log of which state (0..3) the tracing last passed by each pixel with. The 2 bit values are stored in 32x32 pixel
+* tiles that get allocated on first write. Only those tiles need to be reset by clear(), which is typically a small
+* fraction of the image.
+*/
+class TraceHistory
+{
+	static constexpr int TILE_SIZE = 32; // one row of a tile is a single uint64_t
+
+	int _tilesPerRow = 0;
+	std::vector<int> _tileIndex; // index into _tiles (in units of TILE_SIZE rows) or -1 if the tile was not written yet
+	std::vector<uint64_t> _tiles;
+	std::vector<int> _usedTiles; // the positions in _tileIndex of all tiles in use
+
+public:
+	TraceHistory() = default;
+	TraceHistory(int width, int height)
+		: _tilesPerRow((width + TILE_SIZE - 1) / TILE_SIZE), _tileIndex(_tilesPerRow * ((height + TILE_SIZE - 1) / TILE_SIZE), -1)
+	{
+		_usedTiles.reserve(64);
+		_tiles.reserve(64 * TILE_SIZE);
+	}
+
+	int get(PointI p) const
+	{
+		int tile = _tileIndex[p.y / TILE_SIZE * _tilesPerRow + p.x / TILE_SIZE];
+		return tile < 0 ? 0 : (_tiles[tile * TILE_SIZE + p.y % TILE_SIZE] >> (2 * (p.x % TILE_SIZE))) & 3;
+	}
+
+	void set(PointI p, int state)
+	{
+		int& tile = _tileIndex[p.y / TILE_SIZE * _tilesPerRow + p.x / TILE_SIZE];
+		if (tile < 0) {
+			tile = Size(_usedTiles);
+			_usedTiles.push_back(narrow_cast<int>(&tile - _tileIndex.data()));
+			// the memory of previously used tiles is kept, the tiles were zeroed in clear()
+			if (Size(_tiles) < (tile + 1) * TILE_SIZE)
+				_tiles.resize((tile + 1) * TILE_SIZE, 0);
+		}
+		auto& row = _tiles[tile * TILE_SIZE + p.y % TILE_SIZE];
+		int shift = 2 * (p.x % TILE_SIZE);
+		row = (row & ~(uint64_t(3) << shift)) | (uint64_t(state & 3) << shift);
+	}
+
+	// number of tiles written to since the last clear()
+	int usedTiles() const { return Size(_usedTiles); }
+
+	void clear()
+	{
+		for (int i : _usedTiles)
+			_tileIndex[i] = -1;
+		std::fill_n(_tiles.begin(), _usedTiles.size() * TILE_SIZE, 0);
+		_usedTiles.clear();
+	}
+};
+
+} // namespace ZXing::DataMatrix
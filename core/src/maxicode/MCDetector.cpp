@@ -0,0 +1,452 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MCDetector.h"
+
+#include "BitMatrix.h"
+#include "BitMatrixCursor.h"
+#include "ConcentricFinder.h"
+#include "DetectorResult.h"
+#include "LogMatrix.h"
+#include "MCBitMatrixParser.h"
+#include "Pattern.h"
+#include "Quadrilateral.h"
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#ifndef PRINT_DEBUG
+#define printf(...){}
+#endif
+
+namespace ZXing::MaxiCode {
+
+// The modules are addressed by column and row, like in the BitMatrix passed to the decoder. The odd rows are shifted by
+// half a module to the right and the rows are sqrt(3)/2 modules apart. The bullseye is centered on module (14, 16).
+constexpr int CENTER_COL = 14;
+constexpr int CENTER_ROW = 16;
+constexpr double ROW_DISTANCE = 0.8660254;
+constexpr double PI = 3.14159265358979323846;
+
+// the radius of the outer edge of the bullseye in units of the module distance
+constexpr double BULLSEYE_RADIUS = 4.55;
+
+// position of the module center relative to the bullseye center in units of the module distance
+static PointF ModuleCenter(int col, int row)
+{
+	return {col - CENTER_COL + 0.5 * (row & 1), (row - CENTER_ROW) * ROW_DISTANCE};
+}
+
+/**
+* The 3 dark rings and the 2 light rings in between are approximately equally wide, the light center is between 1 and
+* 3 times as wide as a ring. The exact ratio depends on the printer, so only check for rough plausibility.
+*/
+template <typename T>
+static bool IsBullseyePattern(const T& view)
+{
+	int rings = 0, left = 0;
+	for (int i = 0; i < 11; ++i)
+		if (i != 5)
+			rings += view[i], left += (i < 5) * view[i];
+
+	float ring = rings / 10.f;
+	if (ring < 1 || view[5] < ring / 2 || view[5] > ring * 4 || std::abs(rings - 2 * left) > rings / 4)
+		return false;
+
+	for (int i = 0; i < 11; ++i)
+		if (i != 5 && (view[i] < ring / 2 || view[i] > ring * 2))
+			return false;
+
+	return true;
+}
+
+static std::optional<ConcentricPattern> LocateBullseye(const BitMatrix& image, PointF p, int width)
+{
+	int minSpread = width, maxSpread = width;
+	for (auto d : {PointI{0, 1}, {1, 1}, {1, -1}}) {
+		BitMatrixCursorI cur(image, PointI(p), d);
+		auto pattern = ReadSymmetricPattern<11>(cur, width * 2);
+		if (!pattern || !IsBullseyePattern(*pattern))
+			return {};
+		UpdateMinMax(minSpread, maxSpread, static_cast<int>(Reduce(*pattern) * length(PointF(d))));
+	}
+
+	if (maxSpread > 3 * minSpread)
+		return {};
+
+	// the center of the light disc and the rings are each slightly off due to the pixel raster, average them
+	PointF sum = {};
+	int n = 0;
+	for (int i = 1; i <= 5; ++i)
+		if (auto c = CenterOfRing(image, PointI(p), maxSpread, i)) {
+			sum += *c;
+			++n;
+		}
+	if (n < 3)
+		return {};
+
+	auto center = sum / n;
+	if (!image.isIn(center) || image.get(center))
+		return {};
+
+	return ConcentricPattern{center, (minSpread + maxSpread) / 2};
+}
+
+// Search one row for bullseye centers and append them to res
+static void FindBullseyesInRow(const BitMatrix& image, int y, const PatternRow& row, std::vector<ConcentricPattern>& res)
+{
+	PatternView next = row;
+
+	while (next = FindLeftGuard<11>(next, 11, [](const PatternView& view, int) { return IsBullseyePattern(view); }),
+		   next.isValid()) {
+		PointF p(next.pixelsInFront() + next.sum(5) + next[5] / 2.0, y + 0.5);
+
+		// make sure p is not 'inside' an already found pattern area
+		if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
+			log(p);
+			if (auto bullseye = LocateBullseye(image, p, next.sum())) {
+				log(*bullseye, 3);
+				res.push_back(*bullseye);
+			}
+		}
+
+		next.skipPair();
+		next.extend();
+	}
+}
+
+ConcentricRowScan BullseyeRowScan(const BitMatrix& image, bool tryHarder)
+{
+	int skip = tryHarder ? 1 : std::clamp(image.height() / 2 / 100, 1, 5);
+	int margin = tryHarder ? 5 : image.height() / 8;
+
+	return {margin, image.height() - margin, skip, FindBullseyesInRow};
+}
+
+/**
+* The 2x2 matrix of the linear map from the module plane (relative to the bullseye center) into the image.
+*/
+struct LinearMap
+{
+	double a = 0, b = 0, c = 0, d = 0;
+
+	PointF operator()(PointF p) const { return {a * p.x + b * p.y, c * p.x + d * p.y}; }
+	LinearMap operator*(const LinearMap& o) const
+	{
+		return {a * o.a + b * o.c, a * o.b + b * o.d, c * o.a + d * o.c, c * o.b + d * o.d};
+	}
+
+	static LinearMap Rotation(double alpha)
+	{
+		double s = std::sin(alpha), c = std::cos(alpha);
+		return {c, -s, s, c};
+	}
+};
+
+/**
+* Fit the ellipse x^T A x = 1 (centered on the origin) to the points with a linear least squares fit of the 3 elements
+* of the symmetric matrix A and return the map from the unit circle onto that ellipse, which is A^(-1/2).
+*/
+static std::optional<LinearMap> FitEllipse(const std::vector<PointF>& points, const std::vector<bool>& ignore)
+{
+	// normal equations M * (a, b, c) = v for the residuals a x^2 + 2b xy + c y^2 - 1
+	std::array<double, 6> M = {}; // symmetric 3x3: 00, 01, 02, 11, 12, 22
+	std::array<double, 3> v = {};
+	for (size_t i = 0; i < points.size(); ++i) {
+		if (ignore[i])
+			continue;
+		auto [x, y] = points[i];
+		double f[3] = {x * x, 2 * x * y, y * y};
+		M[0] += f[0] * f[0], M[1] += f[0] * f[1], M[2] += f[0] * f[2];
+		M[3] += f[1] * f[1], M[4] += f[1] * f[2], M[5] += f[2] * f[2];
+		v[0] += f[0], v[1] += f[1], v[2] += f[2];
+	}
+
+	auto det3 = [](double a, double b, double c, double d, double e, double f, double g, double h, double i) {
+		return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+	};
+	double det = det3(M[0], M[1], M[2], M[1], M[3], M[4], M[2], M[4], M[5]);
+	if (std::abs(det) < 1e-12)
+		return {};
+
+	// Cramer's rule
+	double a = det3(v[0], M[1], M[2], v[1], M[3], M[4], v[2], M[4], M[5]) / det;
+	double b = det3(M[0], v[0], M[2], M[1], v[1], M[4], M[2], v[2], M[5]) / det;
+	double c = det3(M[0], M[1], v[0], M[1], M[3], v[1], M[2], M[4], v[2]) / det;
+
+	// eigen decomposition of A = R(phi) * diag(l1, l2) * R(-phi)
+	double t = (a + c) / 2, r = std::sqrt((a - c) * (a - c) / 4 + b * b);
+	double l1 = t + r, l2 = t - r;
+	if (l2 <= 0)
+		return {};
+
+	double phi = std::atan2(2 * b, a - c) / 2;
+	return LinearMap::Rotation(phi) * LinearMap{1 / std::sqrt(l1), 0, 0, 1 / std::sqrt(l2)} * LinearMap::Rotation(-phi);
+}
+
+/**
+* Returns the map from the unit circle onto the outer edge of the bullseye. Dark modules touching the bullseye show up
+* as bumps in the traced outline, they are removed in a second pass by ignoring the points that are farthest off.
+*/
+static std::optional<LinearMap> BullseyeShape(const BitMatrix& image, const ConcentricPattern& bullseye)
+{
+	auto points = CollectRingPoints(image, bullseye, bullseye.size, 6, true);
+	if (Size(points) < 16)
+		return {};
+
+	for (auto& p : points)
+		p = p - bullseye;
+
+	std::vector<bool> ignore(points.size(), false);
+	auto shape = FitEllipse(points, ignore);
+	if (!shape)
+		return {};
+
+	// the residuals relative to the fitted ellipse, i.e. the lengths of the points mapped back onto the unit circle
+	auto inv = [](const LinearMap& m) {
+		double det = m.a * m.d - m.b * m.c;
+		return LinearMap{m.d / det, -m.b / det, -m.c / det, m.a / det};
+	};
+	auto shapeInv = inv(*shape);
+	std::vector<double> residuals;
+	residuals.reserve(points.size());
+	for (auto p : points)
+		residuals.push_back(std::abs(length(shapeInv(p)) - 1));
+
+	auto sorted = residuals;
+	std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+	double limit = std::max(0.02, 3 * sorted[sorted.size() / 2]);
+	for (size_t i = 0; i < points.size(); ++i)
+		ignore[i] = residuals[i] > limit;
+
+	return FitEllipse(points, ignore);
+}
+
+struct OrientationModule
+{
+	int col, row;
+	bool dark;
+};
+
+// The 18 modules in 6 groups of 3 around the bullseye that determine the orientation of the symbol
+constexpr OrientationModule ORIENTATION_MODULES[] = {
+	{10, 9, true},  {11, 9, true},   {11, 10, true},  // top left
+	{17, 9, false}, {17, 10, false}, {18, 10, false}, // top right
+	{7, 15, true},  {7, 16, false},  {8, 16, true},   // left
+	{20, 16, true}, {21, 16, false}, {20, 17, true},  // right
+	{10, 22, true}, {11, 22, false}, {10, 23, true},  // bottom left
+	{17, 22, true}, {16, 23, false}, {17, 23, true},  // bottom right
+};
+
+/**
+* Find the rotation of the symbol by trying all angles (in 1 degree steps) and counting the matching orientation
+* modules. The range of angles with a perfect (or the best) score is typically a few degrees wide, the center of it is
+* returned in radians.
+*/
+static std::optional<double> FindOrientation(const BitMatrix& image, PointF center, const LinearMap& mod2pix)
+{
+	constexpr int N = 360;
+	constexpr int MIN_SCORE = Size(ORIENTATION_MODULES) - 2;
+
+	std::array<int, N> scores = {};
+	for (int i = 0; i < N; ++i) {
+		auto m = mod2pix * LinearMap::Rotation(2 * PI * i / N);
+		for (auto [col, row, dark] : ORIENTATION_MODULES) {
+			auto p = center + m(ModuleCenter(col, row));
+			scores[i] += image.isIn(p) && image.get(p) == dark;
+		}
+	}
+
+	int best = *std::max_element(scores.begin(), scores.end());
+	if (best < MIN_SCORE)
+		return {};
+
+	// find the longest (cyclic) run of best scores
+	int runStart = 0, runLength = 0;
+	for (int i = 0; i < N; ++i) {
+		if (scores[i] != best || scores[(i + N - 1) % N] == best)
+			continue;
+		int n = 0;
+		while (n < N && scores[(i + n) % N] == best)
+			++n;
+		if (n > runLength)
+			runStart = i, runLength = n;
+	}
+	if (runLength == 0) // all angles have the best score
+		return {};
+
+	printf("orientation: %d, %d° +- %d\n", best, runStart + runLength / 2, runLength / 2);
+
+	return 2 * PI * (runStart + (runLength - 1) / 2.) / N;
+}
+
+/**
+* Returns the offset of the center of the dark dot containing p along the (unit) direction d, if both edges of the dot
+* are within maxDist.
+*/
+static std::optional<double> DotCenterOffset(const BitMatrix& image, PointF p, PointF d, double maxDist)
+{
+	constexpr double STEP = 0.5;
+	std::array<double, 2> edges;
+	for (int i = 0; i < 2; ++i) {
+		auto dir = i ? -1 * d : d;
+		double t = 0;
+		while (t <= maxDist && image.isIn(p + t * dir) && image.get(p + t * dir))
+			t += STEP;
+		if (t > maxDist || !image.isIn(p + t * dir))
+			return {};
+		edges[i] = t - STEP / 2;
+	}
+	return (edges[0] - edges[1]) / 2;
+}
+
+/**
+* A perspective transformation from the module plane into the image, fitted with linear least squares to a set of
+* point correspondences. The coefficient h33 is fixed to 1.
+*/
+class Homography
+{
+	std::array<double, 8> _h = {};
+
+public:
+	Homography(const LinearMap& m, PointF t) : _h{m.a, m.b, t.x, m.c, m.d, t.y, 0, 0} {}
+
+	explicit Homography(const std::vector<std::pair<PointF, PointF>>& pairs) { fit(pairs); }
+
+	bool isValid() const { return !std::isnan(_h[0]); }
+
+	PointF operator()(PointF p) const
+	{
+		double w = _h[6] * p.x + _h[7] * p.y + 1;
+		return {(_h[0] * p.x + _h[1] * p.y + _h[2]) / w, (_h[3] * p.x + _h[4] * p.y + _h[5]) / w};
+	}
+
+	void fit(const std::vector<std::pair<PointF, PointF>>& pairs)
+	{
+		// normal equations of x * (h6 u + h7 v + 1) = h0 u + h1 v + h2 and the same for y with h3..h5
+		std::array<std::array<double, 9>, 8> m = {};
+		auto add = [&m](const std::array<double, 8>& row, double rhs) {
+			for (int i = 0; i < 8; ++i) {
+				for (int j = 0; j < 8; ++j)
+					m[i][j] += row[i] * row[j];
+				m[i][8] += row[i] * rhs;
+			}
+		};
+		for (auto [uv, xy] : pairs) {
+			auto [u, v] = uv;
+			auto [x, y] = xy;
+			add({u, v, 1, 0, 0, 0, -u * x, -v * x}, x);
+			add({0, 0, 0, u, v, 1, -u * y, -v * y}, y);
+		}
+
+		// Gaussian elimination with partial pivoting
+		for (int c = 0; c < 8; ++c) {
+			int p = c;
+			for (int r = c + 1; r < 8; ++r)
+				if (std::abs(m[r][c]) > std::abs(m[p][c]))
+					p = r;
+			if (std::abs(m[p][c]) < 1e-9) {
+				_h[0] = NAN;
+				return;
+			}
+			std::swap(m[c], m[p]);
+			for (int r = 0; r < 8; ++r)
+				if (r != c) {
+					double f = m[r][c] / m[c][c];
+					for (int j = c; j < 9; ++j)
+						m[r][j] -= f * m[c][j];
+				}
+		}
+		for (int i = 0; i < 8; ++i)
+			_h[i] = m[i][8] / m[i][i];
+	}
+};
+
+/**
+* The map derived from the bullseye is only accurate close to it. Locate the center of the dark dots within the given
+* radius (in modules) around the bullseye and fit the perspective transformation to them. Repeating this with growing
+* radii extends the area in which the prediction is precise enough to locate the next dots.
+*/
+static Homography RefineTransform(const BitMatrix& image, const Homography& mod2Pix, double radius)
+{
+	std::vector<std::pair<PointF, PointF>> pairs;
+	pairs.reserve(BitMatrixParser::MATRIX_WIDTH * BitMatrixParser::MATRIX_HEIGHT / 2);
+	// the bullseye center is the most precisely known point
+	for (int i = 0; i < 10; ++i)
+		pairs.emplace_back(PointF(), mod2Pix(PointF()));
+
+	for (int row = 0; row < BitMatrixParser::MATRIX_HEIGHT; ++row)
+		for (int col = 0; col < BitMatrixParser::MATRIX_WIDTH - (row & 1); ++col) {
+			auto uv = ModuleCenter(col, row);
+			double r = length(uv);
+			if (r > radius || r < BULLSEYE_RADIUS + 1)
+				continue;
+			auto p = mod2Pix(uv);
+			if (!image.isIn(p) || !image.get(p))
+				continue;
+			// the size of a module in pixels, the dots can be a bit larger than that due to ink spread
+			double size = distance(mod2Pix(uv + PointF(0.5, 0)), mod2Pix(uv - PointF(0.5, 0)));
+			auto dx = DotCenterOffset(image, p, {1, 0}, 0.8 * size);
+			auto dy = DotCenterOffset(image, p, {0, 1}, 0.8 * size);
+			if (dx && dy)
+				pairs.emplace_back(uv, p + PointF(*dx, *dy));
+		}
+
+	printf("refine %.0f: %d dots\n", radius, Size(pairs) - 10);
+	if (Size(pairs) < 10 + 8)
+		return mod2Pix;
+
+	Homography res(pairs);
+	if (!res.isValid())
+		return mod2Pix;
+
+	// remove the dots that are off by more than a quarter module, they are probably merged with neighbors
+	auto size = distance(res(PointF(0.5, 0)), res(PointF(-0.5, 0)));
+	pairs.erase(std::remove_if(pairs.begin(), pairs.end(), [&](auto& p) { return distance(res(p.first), p.second) > size / 4; }),
+				pairs.end());
+	printf("refine %.0f: %d dots\n", radius, Size(pairs) - 10);
+	res.fit(pairs);
+
+	return res.isValid() ? res : mod2Pix;
+}
+
+DetectorResult Detect(const BitMatrix& image, const ConcentricPattern& bullseye)
+{
+	auto shape = BullseyeShape(image, bullseye);
+	if (!shape)
+		return {};
+
+	auto scale = LinearMap{1 / BULLSEYE_RADIUS, 0, 0, 1 / BULLSEYE_RADIUS};
+	auto angle = FindOrientation(image, bullseye, *shape * scale);
+	if (!angle)
+		return {};
+
+	auto mod2Pix = Homography(*shape * scale * LinearMap::Rotation(*angle), bullseye);
+
+	for (double radius : {8, 11, 14, 20})
+		mod2Pix = RefineTransform(image, mod2Pix, radius);
+
+	BitMatrix bits(BitMatrixParser::MATRIX_WIDTH, BitMatrixParser::MATRIX_HEIGHT);
+	for (int row = 0; row < BitMatrixParser::MATRIX_HEIGHT; ++row)
+		for (int col = 0; col < BitMatrixParser::MATRIX_WIDTH - (row & 1); ++col) {
+			auto p = mod2Pix(ModuleCenter(col, row));
+			if (!image.isIn(p))
+				return {};
+			log(p, 1);
+			if (image.get(p))
+				bits.set(col, row);
+		}
+
+	// the symbol outline in the module plane, the odd rows stick out by half a module on the right
+	auto corner = [&](double col, double row) { return PointI(mod2Pix({col - CENTER_COL, (row - CENTER_ROW) * ROW_DISTANCE})); };
+	constexpr double L = -0.5, T = -0.5, R = BitMatrixParser::MATRIX_WIDTH, B = BitMatrixParser::MATRIX_HEIGHT - 0.5;
+	return {std::move(bits), {corner(L, T), corner(R, T), corner(R, B), corner(L, B)}};
+}
+
+} // namespace ZXing::MaxiCode
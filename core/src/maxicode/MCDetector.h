@@ -0,0 +1,30 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "ConcentricScan.h"
+
+namespace ZXing {
+
+class BitMatrix;
+class DetectorResult;
+
+namespace MaxiCode {
+
+/**
+* The row scan searching for the center of the bullseye finder pattern, see ScanRowsForConcentricPatterns().
+*/
+ConcentricRowScan BullseyeRowScan(const BitMatrix& image, bool tryHarder);
+
+/**
+* Sample the hexagonal module grid of the symbol around the bullseye. The outline of the bullseye rings determines
+* the scale and skew, the orientation modules around it determine the rotation and the data modules are then used
+* to compensate for the perspective distortion.
+*/
+DetectorResult Detect(const BitMatrix& image, const ConcentricPattern& bullseye);
+
+} // MaxiCode
+} // ZXing
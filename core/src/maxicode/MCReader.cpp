@@ -8,12 +8,17 @@
 
 #include "BinaryBitmap.h"
 #include "BitMatrix.h"
+#include "ConcentricScan.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
 #include "MCBitMatrixParser.h"
 #include "MCDecoder.h"
+#include "MCDetector.h"
+#include "ReaderOptions.h"
 #include "Barcode.h"
 
+#include <utility>
+
 namespace ZXing::MaxiCode {
 
 /**
@@ -47,22 +52,39 @@ static DetectorResult ExtractPureBits(const BitMatrix& image)
 }
 
 Barcode Reader::decode(const BinaryBitmap& image) const
+{
+	return FirstOrDefault(decode(image, 1));
+}
+
+Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 {
 	auto binImg = image.getBitMatrix();
 	if (binImg == nullptr)
 		return {};
 
-	//TODO: this only works with effectively 'pure' barcodes. Needs proper detector.
-	auto detRes = ExtractPureBits(*binImg);
-	if (!detRes.isValid())
-		return {};
+	Barcodes res;
+	auto decode = [&](DetectorResult&& detRes) {
+		if (!detRes.isValid())
+			return;
+		DecoderResult decRes = Decode(detRes.bits());
+		// TODO: before we can meaningfully return a ChecksumError result, we need to check the center for the presence of the finder pattern
+		if (decRes.isValid())
+			res.emplace_back(std::move(decRes), std::move(detRes), BarcodeFormat::MaxiCode);
+	};
 
-	DecoderResult decRes = Decode(detRes.bits());
-	// TODO: before we can meaningfully return a ChecksumError result, we need to check the center for the presence of the finder pattern
-	if (!decRes.isValid())
-		return {};
+	if (!_opts.isPure()) {
+		for (const auto& bullseye : FindConcentricPatterns(image, BarcodeFormat::MaxiCode, _opts)) {
+			decode(Detect(*binImg, bullseye));
+			if (maxSymbols > 0 && Size(res) >= maxSymbols)
+				return res;
+		}
+	}
+
+	// synthetic symbols are not necessarily printed with a bullseye that is close enough to the specification
+	if (res.empty())
+		decode(ExtractPureBits(*binImg));
 
-	return Barcode(std::move(decRes), std::move(detRes), BarcodeFormat::MaxiCode);
+	return res;
 }
 
 } // namespace ZXing::MaxiCode
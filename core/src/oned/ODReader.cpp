@@ -7,6 +7,7 @@
 
 #include "ODReader.h"
 
+#include "BarcodeIndex.h"
 #include "BinaryBitmap.h"
 #include "ReaderOptions.h"
 #include "ODCodabarReader.h"
@@ -22,7 +23,10 @@
 #include "Barcode.h"
 
 #include <algorithm>
+#include <deque>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #ifdef PRINT_DEBUG
 #include "BitMatrix.h"
@@ -40,6 +44,46 @@ void IncrementLineCount(Barcode& r)
 
 namespace ZXing::OneD {
 
+// Area (in scan coordinates, i.e. before the potential rotation) covered by the rows a symbol was found in.
+struct ScanArea
+{
+	int left, right, top, bottom;
+
+	void merge(const ScanArea& o)
+	{
+		left = std::min(left, o.left);
+		right = std::max(right, o.right);
+		top = std::min(top, o.top);
+		bottom = std::max(bottom, o.bottom);
+	}
+};
+
+// Determine the ranges of bars/spaces (see PatternView::index()) of the given row, which are completely inside
+// of one of the given pixel ranges [left, right].
+static void FindSkipRanges(const PatternRow& bars, std::vector<std::pair<int, int>> spans, std::vector<std::pair<int, int>>& res)
+{
+	res.clear();
+	if (spans.empty())
+		return;
+
+	std::sort(spans.begin(), spans.end());
+	auto span = spans.begin();
+	int x = bars[0];
+	// index i corresponds to bars[i + 1]
+	for (int i = 0; i < Size(bars) - 1 && span != spans.end(); ++i) {
+		int xEnd = x + bars[i + 1];
+		while (span != spans.end() && span->second < x)
+			++span;
+		if (span != spans.end() && x >= span->first && xEnd - 1 <= span->second) {
+			if (!res.empty() && res.back().second == i)
+				res.back().second = i + 1;
+			else
+				res.push_back({i, i + 1});
+		}
+		x = xEnd;
+	}
+}
+
 Reader::Reader(const ReaderOptions& opts) : ZXing::Reader(opts)
 {
 	_readers.reserve(8);
@@ -79,11 +123,20 @@ Reader::~Reader() = default;
 * rowStep is bigger as the image is taller, but is always at least 1. We've somewhat arbitrarily
 * decided that moving up and down by about 1/16 of the image is pretty good; we try more of the
 * image if "trying harder".
+*
+* If we are looking for more than one symbol, the rows are scheduled adaptively: the image is first scanned
+* coarsely with the single symbol rowStep. Around every row that produced a result, the rows of a grid with half
+* that step are scanned in addition. Since every refined row that produces a result extends the refined area, this
+* grows across stacks of short symbols, which could otherwise fall between two coarse rows. Parts of rows that lie
+* inside of an already confirmed symbol are not looked at again.
 */
 static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const BinaryBitmap& image, bool tryHarder,
 						 bool rotate, bool isPure, int maxSymbols, int minLineCount, bool returnErrors)
 {
 	Barcodes res;
+	std::vector<ScanArea> areas; // same order as res
+	BarcodeIndex index(std::max(image.width(), image.height()));
+	int numConfirmed = 0; // number of symbols in res with at least minLineCount lines
 
 	std::vector<std::unique_ptr<RowReader::DecodingState>> decodingState(readers.size());
 
@@ -94,21 +147,28 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 		std::swap(width, height);
 
 	int middle = height / 2;
-	// TODO: find a better heuristic/parameterization if maxSymbols != 1
-	int rowStep = std::max(1, height / ((tryHarder && !isPure) ? (maxSymbols == 1 ? 256 : 512) : 32));
+	int rowStep = std::max(1, height / ((tryHarder && !isPure) ? 256 : 32));
 	int maxLines = tryHarder ?
 		height :	// Look at the whole image, not just the center
 		15;			// 15 rows spaced 1/32 apart is roughly the middle half of the image
+	// a multi-symbol scan needs a finer step to not miss short symbols stacked on top of each other, it is only used
+	// in the vicinity of previous detections
+	int refineStep = std::max(1, height / 512);
+	bool adaptive = tryHarder && !isPure && maxSymbols != 1 && refineStep < rowStep;
 
 	if (isPure)
 		minLineCount = 1;
 	else
 		minLineCount = std::min(minLineCount, height);
 	std::vector<int> checkRows;
+	std::deque<int> refineRows;
+	std::vector<bool> scannedRows(adaptive ? height : 0);
 
 	PatternRow bars;
 	bars.reserve(128); // e.g. EAN-13 has 59 bars/spaces
 
+	std::vector<std::pair<int, int>> skipSpans, skipRanges;
+
 #ifdef PRINT_DEBUG
 	BitMatrix dbg(width, height);
 #endif
@@ -120,12 +180,12 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 		bool isAbove = (i & 0x01) == 0; // i.e. is x even?
 		int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
 		bool isCheckRow = false;
-		if (rowNumber < 0 || rowNumber >= height) {
+		if ((rowNumber < 0 || rowNumber >= height) && refineRows.empty()) {
 			// Oops, if we run off the top or bottom, stop
 			break;
 		}
 
-		// See if we have additional check rows (see below) to process
+		// See if we have additional check rows or refinement rows (see below) to process
 		if (checkRows.size()) {
 			--i;
 			rowNumber = checkRows.back();
@@ -133,11 +193,31 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 			isCheckRow = true;
 			if (rowNumber < 0 || rowNumber >= height)
 				continue;
+		} else if (refineRows.size()) {
+			--i;
+			rowNumber = refineRows.front();
+			refineRows.pop_front();
+		}
+
+		if (adaptive) {
+			if (scannedRows[rowNumber])
+				continue;
+			scannedRows[rowNumber] = true;
 		}
 
 		if (!image.getPatternRow(rowNumber, rotate ? 90 : 0, bars))
 			continue;
 
+		// collect the horizontal spans of all confirmed symbols that this row crosses
+		skipSpans.clear();
+		auto row = rotate ? Position(PointI{rowNumber, 0}, {rowNumber, width - 1}, {rowNumber, width - 1}, {rowNumber, 0})
+						  : Position(PointI{0, rowNumber}, {width - 1, rowNumber}, {width - 1, rowNumber}, {0, rowNumber});
+		for (int j : index.overlapping(row))
+			if (res[j].lineCount() >= minLineCount && areas[j].top < rowNumber && rowNumber < areas[j].bottom)
+				skipSpans.push_back({areas[j].left, areas[j].right});
+
+		bool foundSymbolInRow = false;
+
 #ifdef PRINT_DEBUG
 		bool val = false;
 		int x = 0;
@@ -159,7 +239,11 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 			if (upsideDown) {
 				// reverse the row and continue
 				std::reverse(bars.begin(), bars.end());
+				for (auto& [l, r] : skipSpans)
+					std::tie(l, r) = std::pair(width - r - 1, width - l - 1);
 			}
+			FindSkipRanges(bars, skipSpans, skipRanges);
+
 			// Look for a barcode
 			for (size_t r = 0; r < readers.size(); ++r) {
 				// If this is a pure symbol, then checking a single non-empty line is sufficient for all but the stacked
@@ -169,9 +253,25 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 
 				PatternView next(bars);
 				do {
+					// skip the parts of the row that belong to a confirmed symbol and stop in front of the next one
+					for (auto [first, last] : skipRanges) {
+						if (next.index() >= last)
+							continue;
+						if (next.index() >= first) {
+							next.shift(last - next.index() + (last % 2));
+							next.extend();
+						} else {
+							next = next.subView(0, first - next.index());
+							break;
+						}
+					}
+					if (!next.size())
+						break;
+
 					Barcode result = readers[r]->decodePattern(rowNumber, next, decodingState[r]);
 					if (result.isValid() || (returnErrors && result.error())) {
 						IncrementLineCount(result);
+						foundSymbolInRow = true;
 						if (upsideDown) {
 							// update position (flip horizontally).
 							auto points = result.position();
@@ -180,6 +280,9 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 							}
 							result.setPosition(std::move(points));
 						}
+						ScanArea area = {result.position().topLeft().x, result.position().topLeft().x, rowNumber, rowNumber};
+						for (auto& p : result.position())
+							UpdateMinMax(area.left, area.right, p.x);
 						if (rotate) {
 							auto points = result.position();
 							for (auto& p : points) {
@@ -189,22 +292,41 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 						}
 
 						// check if we know this code already
-						for (auto& other : res) {
+						for (int j : index.candidates(result)) {
+							auto& other = res[j];
 							if (result == other) {
 								// merge the position information
-								auto dTop = maxAbsComponent(other.position().topLeft() - result.position().topLeft());
-								auto dBot = maxAbsComponent(other.position().bottomLeft() - result.position().topLeft());
 								auto points = other.position();
-								if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(points[0]) >
-																			  sumAbsComponent(result.position()[0])))) {
-									points[0] = result.position()[0];
-									points[1] = result.position()[1];
+								auto p = result.position();
+								if (adaptive) {
+									// the rows are not scanned from the middle out, so only extend the position, never shrink it
+									auto length = [rotate](PointI a, PointI b) { return std::abs(rotate ? a.x - b.x : a.y - b.y); };
+									for (auto [left, right] : {std::pair(p[0], p[1]), std::pair(p[3], p[2])}) {
+										int current = length(points[0], points[3]);
+										if (length(left, points[3]) > std::max(current, length(points[0], left))) {
+											points[0] = left;
+											points[1] = right;
+										} else if (length(points[0], left) > current) {
+											points[3] = left;
+											points[2] = right;
+										}
+									}
 								} else {
-									points[2] = result.position()[2];
-									points[3] = result.position()[3];
+									auto dTop = maxAbsComponent(points.topLeft() - p.topLeft());
+									auto dBot = maxAbsComponent(points.bottomLeft() - p.topLeft());
+									if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(points[0]) > sumAbsComponent(p[0])))) {
+										points[0] = p[0];
+										points[1] = p[1];
+									} else {
+										points[2] = p[2];
+										points[3] = p[3];
+									}
 								}
 								other.setPosition(points);
+								index.insert(j, other);
 								IncrementLineCount(other);
+								numConfirmed += other.lineCount() == minLineCount;
+								areas[j].merge(area);
 								// clear the result, so we don't insert it again below
 								result = Barcode();
 								break;
@@ -212,7 +334,10 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 						}
 
 						if (result.format() != BarcodeFormat::None) {
+							numConfirmed += result.lineCount() >= minLineCount;
 							res.push_back(std::move(result));
+							areas.push_back(area);
+							index.insert(Size(res) - 1, res.back());
 
 							// if we found a valid code we have not seen before but a minLineCount > 1,
 							// add additional check rows above and below the current one
@@ -223,11 +348,8 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 							}
 						}
 
-						if (maxSymbols && Reduce(res, 0, [&](int s, const Barcode& r) {
-											  return s + (r.lineCount() >= minLineCount);
-										  }) == maxSymbols) {
+						if (maxSymbols && numConfirmed == maxSymbols)
 							goto out;
-						}
 					}
 					// make sure we make progress and we start the next try on a bar
 					next.shift(2 - (next.index() % 2));
@@ -235,6 +357,20 @@ static Barcodes DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers,
 				} while (tryHarder && next.size());
 			}
 		}
+
+		// refine the coarse scan in the neighborhood of rows that produced a result: the 2 * rowStep range bridges the
+		// gaps between stacked symbols that are shorter than rowStep
+		if (adaptive && foundSymbolInRow && !isCheckRow) {
+			int first = std::max(0, rowNumber - 2 * rowStep), last = std::min(height - 1, rowNumber + 2 * rowStep);
+			// align the refinement rows to a common grid, so that overlapping neighborhoods share their rows
+			auto begin = refineRows.size();
+			for (int r = middle - (middle - first) / refineStep * refineStep; r <= last; r += refineStep)
+				if (!scannedRows[r])
+					refineRows.push_back(r);
+			// scan from the current row outward, like the coarse scan does from the middle
+			std::sort(refineRows.begin() + begin, refineRows.end(),
+					  [&](int a, int b) { return std::abs(a - rowNumber) < std::abs(b - rowNumber); });
+		}
 	}
 
 out:
@@ -247,10 +383,13 @@ out:
 #endif
 
 	// if symbols overlap, remove the one with a lower line count
-	for (auto a = res.begin(); a != res.end(); ++a)
-		for (auto b = std::next(a); b != res.end(); ++b)
-			if (HaveIntersectingBoundingBoxes(a->position(), b->position()))
-				*(a->lineCount() < b->lineCount() ? a : b) = Barcode();
+	BarcodeIndex overlaps(std::max(image.width(), image.height()));
+	for (int i = 0; i < Size(res); ++i)
+		overlaps.insert(i, res[i]);
+	for (int a = 0; a < Size(res); ++a)
+		for (int b : overlaps.overlapping(res[a].position()))
+			if (b > a && res[a].format() != BarcodeFormat::None && res[b].format() != BarcodeFormat::None)
+				res[res[a].lineCount() < res[b].lineCount() ? a : b] = Barcode();
 
 #ifdef __cpp_lib_erase_if
 	std::erase_if(res, [](auto&& r) { return r.format() == BarcodeFormat::None; });
@@ -284,7 +423,7 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	if ((!maxSymbols || Size(resH) < maxSymbols) && _opts.tryRotate()) {
 		auto resV = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), maxSymbols - Size(resH),
 							 _opts.minLineCount(), _opts.returnErrors());
-		resH.insert(resH.end(), resV.begin(), resV.end());
+		resH.insert(resH.end(), std::move_iterator(resV.begin()), std::move_iterator(resV.end()));
 	}
 	return resH;
 }
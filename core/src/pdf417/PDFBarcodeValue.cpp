@@ -11,37 +11,78 @@
 namespace ZXing {
 namespace Pdf417 {
 
+void
+BarcodeValues::init(int numCells)
+{
+	_slots.assign(numCells * SLOTS, {});
+	_overflow.clear();
+}
+
 /**
 * Add an occurrence of a value
 */
 void
-BarcodeValue::setValue(int value)
+BarcodeValues::setValue(int cell, int value)
 {
-	_values[value] += 1;
+	auto* slots = _slots.data() + cell * SLOTS;
+	for (int i = 0; i < SLOTS; ++i) {
+		if (slots[i].count == 0)
+			slots[i].value = value;
+		if (slots[i].value == value) {
+			++slots[i].count;
+			return;
+		}
+	}
+
+	for (auto& [c, vote] : _overflow)
+		if (c == cell && vote.value == value) {
+			++vote.count;
+			return;
+		}
+	_overflow.push_back({cell, {value, 1}});
 }
 
 /**
 * Determines the maximum occurrence of a set value and returns all values which were set with this occurrence.
 * @return an array of int, containing the values with the highest occurrence, or null, if no value was set
 */
-std::vector<int>
-BarcodeValue::value() const
+void
+BarcodeValues::value(int cell, std::vector<int>& result) const
 {
-	std::vector<int> result;
-	if (!_values.empty()) {
-		int maxConfidence = std::max_element(_values.begin(), _values.end(), [](auto& l, auto& r) { return l.second < r.second; })->second;
-		for (auto [value, count] : _values)
-			if (count == maxConfidence)
-				result.push_back(value);
-	}
-	return result;
+	result.clear();
+	int maxConfidence = 0;
+	auto add = [&](const Vote& vote) {
+		if (vote.count > maxConfidence) {
+			maxConfidence = vote.count;
+			result.clear();
+		}
+		if (vote.count && vote.count == maxConfidence)
+			result.push_back(vote.value);
+	};
+
+	const auto* slots = _slots.data() + cell * SLOTS;
+	std::for_each(slots, slots + SLOTS, add);
+	if (slots[SLOTS - 1].count)
+		for (auto& [c, vote] : _overflow)
+			if (c == cell)
+				add(vote);
+
+	if (result.size() > 1)
+		std::sort(result.begin(), result.end());
 }
 
 int
-BarcodeValue::confidence(int value) const
+BarcodeValues::confidence(int cell, int value) const
 {
-	auto it = _values.find(value);
-	return it != _values.end() ? it->second : 0;
+	const auto* slots = _slots.data() + cell * SLOTS;
+	for (int i = 0; i < SLOTS; ++i)
+		if (slots[i].count && slots[i].value == value)
+			return slots[i].count;
+
+	for (auto& [c, vote] : _overflow)
+		if (c == cell && vote.value == value)
+			return vote.count;
+	return 0;
 }
 
 } // Pdf417
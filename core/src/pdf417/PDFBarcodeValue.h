@@ -6,32 +6,56 @@
 
 #pragma once
 
-#include <map>
+#include <utility>
 #include <vector>
 
 namespace ZXing {
 namespace Pdf417 {
 
 /**
+* Collects the votes for the values of a number of cells (e.g. the rows x columns of the barcode matrix) in one flat
+* array with a small fixed number of vote slots per cell. The rare cells with more distinct values spill over into
+* a shared overflow list. Calling init() again reuses the allocated memory.
+*
 * @author Guenther Grau
 */
-class BarcodeValue
+class BarcodeValues
 {
-	std::map<int, int> _values;
+	struct Vote
+	{
+		int value = 0;
+		int count = 0; // 0 marks an empty slot
+	};
+
+	static constexpr int SLOTS = 4;
+	std::vector<Vote> _slots;
+	std::vector<std::pair<int, Vote>> _overflow; // cell index, vote
 
 public:
+	BarcodeValues() = default;
+	explicit BarcodeValues(int numCells) { init(numCells); }
+
+	void init(int numCells);
+
 	/**
 	* Add an occurrence of a value
 	*/
-	void setValue(int value);
+	void setValue(int cell, int value);
 
 	/**
 	* Determines the maximum occurrence of a set value and returns all values which were set with this occurrence.
-	* @return an array of int, containing the values with the highest occurrence, or null, if no value was set
+	* @param result the values with the highest occurrence in ascending order, empty if no value was set
 	*/
-	std::vector<int> value() const;
+	void value(int cell, std::vector<int>& result) const;
+
+	std::vector<int> value(int cell) const
+	{
+		std::vector<int> result;
+		value(cell, result);
+		return result;
+	}
 
-	int confidence(int value) const;
+	int confidence(int cell, int value) const;
 };
 
 } // Pdf417
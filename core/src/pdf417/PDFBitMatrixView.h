@@ -0,0 +1,77 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BitMatrix.h"
+#include "Pattern.h"
+#include "Range.h"
+
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+
+namespace ZXing {
+namespace Pdf417 {
+
+/**
+* A read-only view of a BitMatrix, rotated clockwise by 0, 90, 180 or 270 degrees. The rotation is implemented by
+* remapping the coordinates in get(), which means no pixel data is copied. The view does not own the matrix.
+*
+* The rotated coordinates match those of BitMatrix::rotate90() and BitMatrix::rotate180(). The view is cheap to copy,
+* pass it by value into tight loops so the compiler can keep the index mapping in registers.
+*/
+class BitMatrixView
+{
+	const BitMatrix* _bits = nullptr;
+	const uint8_t* _data = nullptr;
+	int _size = 0;
+	int _rotation = 0;
+	// the view coordinates (x, y) map to the index _i0 + _sx * x + _sy * y into the data of _bits
+	int _i0 = 0, _sx = 1, _sy = 0;
+
+public:
+	BitMatrixView() = default;
+	BitMatrixView(const BitMatrix& bits, int rotation)
+		: _bits(&bits), _data(bits.row(0).begin()), _size(bits.width() * bits.height()), _rotation(rotation % 360)
+	{
+		const int w = bits.width(), h = bits.height();
+		switch (_rotation) {
+		case 0: _i0 = 0, _sx = 1, _sy = w; break;
+		case 90: _i0 = w - 1, _sx = w, _sy = -1; break;
+		case 180: _i0 = w * h - 1, _sx = -1, _sy = -w; break;
+		case 270: _i0 = (h - 1) * w, _sx = -w, _sy = 1; break;
+		}
+	}
+
+	int rotation() const { return _rotation; }
+	int width() const { return _rotation % 180 ? _bits->height() : _bits->width(); }
+	int height() const { return _rotation % 180 ? _bits->width() : _bits->height(); }
+
+	bool get(int x, int y) const
+	{
+		int i = _i0 + _sx * x + _sy * y;
+		// same range check as BitMatrix::get()
+		if (i < 0 || i >= _size)
+			throw std::out_of_range("BitMatrixView::get");
+		return _data[i];
+	}
+
+	/**
+	* Run-length encode the pixels of row y from column x up to (but excluding) column xEnd, see GetPatternRow().
+	*/
+	void getPatternRow(int y, int x, int xEnd, PatternRow& res) const
+	{
+		assert(0 <= x && x < xEnd && xEnd <= width() && 0 <= y && y < height());
+		const uint8_t* begin = _data + _i0 + _sx * x + _sy * y;
+		if (_sx == 1)
+			GetPatternRow(Range{begin, begin + (xEnd - x)}, res);
+		else
+			GetPatternRow(Range{StrideIter{begin, _sx}, StrideIter{begin, _sx} + (xEnd - x)}, res);
+	}
+};
+
+} // Pdf417
+} // ZXing
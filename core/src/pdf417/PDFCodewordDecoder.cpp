@@ -5,7 +5,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "PDFCodewordDecoder.h"
-#include "BitArray.h"
+#include "BitHacks.h"
 #include "ZXAlgorithms.h"
 
 #include <algorithm>
@@ -433,10 +433,12 @@ static ModuleBitCountType SampleBitCounts(const ModuleBitCountType& moduleBitCou
 
 static int GetBitValue(const ModuleBitCountType& moduleBitCount)
 {
+	// append moduleBitCount[i] bits at once (they sum up to MODULES_IN_CODEWORD), set for the bars and unset for the spaces
 	int result = 0;
-	for (size_t i = 0; i < moduleBitCount.size(); i++)
-		for (int bit = 0; bit < moduleBitCount[i]; bit++)
-			AppendBit(result, i % 2 == 0);
+	for (int i = 0; i < CodewordDecoder::BARS_IN_MODULE; i++) {
+		int n = moduleBitCount[i];
+		result = (result << n) | (i % 2 == 0 ? (1 << n) - 1 : 0);
+	}
 	return result;
 }
 
@@ -451,31 +453,77 @@ static constexpr int getSymbol(int idx)
 	return SYMBOL_TABLE[idx] | 0x10000;
 }
 
-static int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
+/**
+* Direct index into SYMBOL_TABLE for all 2^16 possible (low 16 bits of) symbols: one bit per symbol, set if it is
+* contained in the table, plus the number of set bits in all preceding words. The index of a symbol is then its rank,
+* i.e. the number of set bits before it. This is a 12kB replacement for a 128kB lookup table.
+*/
+struct SymbolIndex
 {
-#if 1 // put 87kB on heap and calucate per process on first use -> 7% smaller binary
-	static const auto ratioTable = []() {
-		auto table = std::vector<std::array<float, CodewordDecoder::BARS_IN_MODULE>>(SYMBOL_COUNT);
-#else // put 87kB in .rodata shared by all processes and calcuate during compilation
-	static constexpr const auto ratioTable = []() constexpr {
-		auto table = std::array<std::array<float, CodewordDecoder::BARS_IN_MODULE>, SYMBOL_COUNT>();
-#endif
-		for (int i = 0; i < SYMBOL_COUNT; i++) {
-			int currentSymbol = getSymbol(i);
-			int currentBit = currentSymbol & 0x1;
-			for (int j = 0; j < CodewordDecoder::BARS_IN_MODULE; j++) {
-				int8_t size = 0;
-				while ((currentSymbol & 0x1) == currentBit) {
-					size += 1;
-					currentSymbol >>= 1;
-				}
-				currentBit = currentSymbol & 0x1;
-				table[i][CodewordDecoder::BARS_IN_MODULE - j - 1] = size / 17.f; // MODULES_IN_CODEWORD
+	static constexpr int NUM_WORDS = (1 << 16) / 32;
+	std::array<uint32_t, NUM_WORDS> bits = {};
+	std::array<uint16_t, NUM_WORDS> rank = {};
+
+	constexpr SymbolIndex()
+	{
+		for (int s : SYMBOL_TABLE)
+			bits[s / 32] |= 1u << (s % 32);
+		for (int i = 0, count = 0; i < NUM_WORDS; i++) {
+			rank[i] = narrow_cast<uint16_t>(count);
+			for (uint32_t w = bits[i]; w; w &= w - 1)
+				count++;
+		}
+	}
+
+	int operator[](int symbol) const
+	{
+		uint32_t word = bits[symbol / 32];
+		uint32_t bit = 1u << (symbol % 32);
+		return (word & bit) ? rank[symbol / 32] + BitHacks::CountBitsSet(word & (bit - 1)) : -1;
+	}
+};
+
+static constexpr SymbolIndex SYMBOL_INDEX;
+
+/**
+* The widths (1..6 modules) of the 8 bars and spaces of each symbol in SYMBOL_TABLE, calculated during compilation.
+*/
+static constexpr auto BAR_WIDTH_TABLE = []() {
+	std::array<std::array<uint8_t, CodewordDecoder::BARS_IN_MODULE>, SYMBOL_COUNT> table = {};
+	for (int i = 0; i < SYMBOL_COUNT; i++) {
+		int currentSymbol = getSymbol(i);
+		int currentBit = currentSymbol & 0x1;
+		for (int j = 0; j < CodewordDecoder::BARS_IN_MODULE; j++) {
+			uint8_t size = 0;
+			while ((currentSymbol & 0x1) == currentBit) {
+				size += 1;
+				currentSymbol >>= 1;
 			}
+			currentBit = currentSymbol & 0x1;
+			table[i][CodewordDecoder::BARS_IN_MODULE - j - 1] = size;
 		}
-		return table;
-	}();
+	}
+	return table;
+}();
+
+/**
+* SYMBOL_TABLE is sorted, hence all symbols starting with the same k + 1 bar widths are stored next to each other.
+* SKIP_TABLE[i][k] is the index of the first symbol after i with different widths of the first k + 1 bars.
+*/
+static constexpr auto SKIP_TABLE = []() {
+	std::array<std::array<uint16_t, CodewordDecoder::BARS_IN_MODULE>, SYMBOL_COUNT> table = {};
+	for (int i = SYMBOL_COUNT - 1; i >= 0; i--)
+		for (int k = 0, samePrefix = i + 1 < SYMBOL_COUNT; k < CodewordDecoder::BARS_IN_MODULE; k++) {
+			samePrefix = samePrefix && BAR_WIDTH_TABLE[i][k] == BAR_WIDTH_TABLE[i + 1][k];
+			table[i][k] = samePrefix ? table[i + 1][k] : i + 1;
+		}
+	return table;
+}();
+
+static constexpr int MAX_BAR_WIDTH = 6;
 
+static int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
+{
 	int bitCountSum = Reduce(moduleBitCount);
 	std::array<float, CodewordDecoder::BARS_IN_MODULE> bitCountRatios = {};
 	if (bitCountSum > 1) {
@@ -483,22 +531,37 @@ static int GetClosestDecodedValue(const ModuleBitCountType& moduleBitCount)
 			bitCountRatios[i] = moduleBitCount[i] / (float)bitCountSum;
 		}
 	}
+
+	// Each bar of a symbol can only be 1 to 6 modules wide, so there are only 8 * 6 different squared differences
+	// between the ratios of a symbol and the measured ones. Computing them up front reduces the inner loop below to
+	// table lookups and additions (in the same order as before, so the result is the same).
+	std::array<std::array<float, MAX_BAR_WIDTH + 1>, CodewordDecoder::BARS_IN_MODULE> squaredDiffs;
+	for (int k = 0; k < CodewordDecoder::BARS_IN_MODULE; k++)
+		for (int width = 0; width <= MAX_BAR_WIDTH; width++) {
+			float diff = width / 17.f - bitCountRatios[k]; // MODULES_IN_CODEWORD
+			squaredDiffs[k][width] = diff * diff;
+		}
+
 	float bestMatchError = std::numeric_limits<float>::max();
 	int bestMatch = -1;
-	for (size_t j = 0; j < ratioTable.size(); j++) {
+	for (int j = 0; j < SYMBOL_COUNT;) {
 		float error = 0.0f;
-		auto& ratioTableRow = ratioTable[j];
-		for (int k = 0; k < CodewordDecoder::BARS_IN_MODULE; k++) {
-			float diff = ratioTableRow[k] - bitCountRatios[k];
-			error += diff * diff;
+		auto& barWidths = BAR_WIDTH_TABLE[j];
+		int k = 0;
+		for (; k < CodewordDecoder::BARS_IN_MODULE; k++) {
+			error += squaredDiffs[k][barWidths[k]];
 			if (error >= bestMatchError) {
 				break;
 			}
 		}
-		if (error < bestMatchError) {
-			bestMatchError = error;
-			bestMatch = getSymbol(j);
+		if (k < CodewordDecoder::BARS_IN_MODULE) {
+			// all following symbols with the same first k + 1 bars have the same partial error, skip them
+			j = SKIP_TABLE[j][k];
+			continue;
 		}
+		bestMatchError = error;
+		bestMatch = getSymbol(j);
+		j++;
 	}
 	return bestMatch;
 }
@@ -522,12 +585,8 @@ CodewordDecoder::GetCodeword(int symbol)
 {
 	if ((symbol & 0xFFFF0000) != 0x10000)
 		return -1;
-	symbol &= 0xFFFF;
-	auto it = std::lower_bound(SYMBOL_TABLE.begin(), SYMBOL_TABLE.end(), symbol);
-	if (it != SYMBOL_TABLE.end() && *it == symbol) {
-		return (CODEWORD_TABLE[it - SYMBOL_TABLE.begin()] - 1) % NUMBER_OF_CODEWORDS;
-	}
-	return -1;
+	int idx = SYMBOL_INDEX[symbol & 0xFFFF];
+	return idx == -1 ? -1 : (CODEWORD_TABLE[idx] - 1) % NUMBER_OF_CODEWORDS;
 }
 
 } // Pdf417
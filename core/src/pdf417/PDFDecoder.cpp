@@ -10,7 +10,6 @@
 #include "DecoderResult.h"
 #include "PDFCustomData.h"
 #include "ZXAlgorithms.h"
-#include "ZXBigInteger.h"
 #include "ZXTestSupport.h"
 
 #include <array>
@@ -450,23 +449,40 @@ Remove leading 1 =>  Result is 000213298174000
 */
 static std::string DecodeBase900toBase10(const std::vector<int>& codewords, int endIndex, int count)
 {
-	// Table containing values for the exponent of 900.
-	static const auto EXP900 = []() {
-		std::array<BigInteger, 16> table = {1, 900};
-		for (size_t i = 2; i < table.size(); ++i)
-			table[i] = table[i - 1] * 900;
-		return table;
-	}();
-
 	assert(count <= 16);
 
-	BigInteger result;
-	for (int i = 0; i < count; i++)
-		result += EXP900[count - i - 1] * codewords[endIndex - count + i];
+	// The value is accumulated in base 10^9 'limbs' (least significant first) on the stack. 16 codewords (< 929 each)
+	// are less than 10^48, so 6 limbs are sufficient and the conversion to decimal digits is trivial.
+	constexpr uint32_t LIMB_BASE = 1'000'000'000;
+	constexpr int LIMB_DIGITS = 9;
+	constexpr int NUM_LIMBS = 6;
+	std::array<uint32_t, NUM_LIMBS> limbs = {};
+	for (int i = endIndex - count; i < endIndex; i++) {
+		// Horner's method: result = result * 900 + codeword
+		uint64_t carry = codewords[i];
+		for (auto& limb : limbs) {
+			carry += uint64_t(limb) * 900;
+			limb = narrow_cast<uint32_t>(carry % LIMB_BASE);
+			carry /= LIMB_BASE;
+		}
+	}
+
+	int top = NUM_LIMBS - 1;
+	while (top > 0 && limbs[top] == 0)
+		--top;
+
+	std::array<char, NUM_LIMBS * LIMB_DIGITS> buffer;
+	char* end = std::to_chars(buffer.data(), buffer.data() + LIMB_DIGITS, limbs[top]).ptr;
+	for (int i = top - 1; i >= 0; --i) {
+		auto digits = std::to_chars(end, end + LIMB_DIGITS, limbs[i]).ptr;
+		// right-align the digits of the limb and pad with leading zeros
+		std::copy_backward(end, digits, end + LIMB_DIGITS);
+		std::fill(end, end + LIMB_DIGITS - (digits - end), '0');
+		end += LIMB_DIGITS;
+	}
 
-	std::string resultString = result.toString();
-	if (!resultString.empty() && resultString.front() == '1')
-		return resultString.substr(1);
+	if (buffer[0] == '1')
+		return std::string(buffer.data() + 1, end);
 
 	throw FormatError();
 }
@@ -682,8 +698,8 @@ DecoderResult Decode(const std::vector<int>& codewords)
 				break;
 			}
 		}
-	} catch (std::exception& e) {
-		return FormatError(e.what());
+	} catch (std::exception& e) { // e.g. std::out_of_range from std::stoi in DecodeMacroBlock
+		return Error(__FILE__, __LINE__, Error::Format, e.what());
 	} catch (Error e) {
 		return e;
 	}
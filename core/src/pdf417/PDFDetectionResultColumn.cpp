@@ -275,10 +275,8 @@ DetectionResultColumn::getBarcodeMetadata(BarcodeMetadata& result)
 	}
 
 	auto& codewords = allCodewords();
-	BarcodeValue barcodeColumnCount;
-	BarcodeValue barcodeRowCountUpperPart;
-	BarcodeValue barcodeRowCountLowerPart;
-	BarcodeValue barcodeECLevel;
+	enum { COLUMN_COUNT, ROW_COUNT_UPPER_PART, ROW_COUNT_LOWER_PART, EC_LEVEL, NUM_VALUES };
+	BarcodeValues values(NUM_VALUES);
 	for (auto& item : codewords) {
 		if (item == nullptr) {
 			continue;
@@ -292,22 +290,22 @@ DetectionResultColumn::getBarcodeMetadata(BarcodeMetadata& result)
 		}
 		switch (codewordRowNumber % 3) {
 		case 0:
-			barcodeRowCountUpperPart.setValue(rowIndicatorValue * 3 + 1);
+			values.setValue(ROW_COUNT_UPPER_PART, rowIndicatorValue * 3 + 1);
 			break;
 		case 1:
-			barcodeECLevel.setValue(rowIndicatorValue / 3);
-			barcodeRowCountLowerPart.setValue(rowIndicatorValue % 3);
+			values.setValue(EC_LEVEL, rowIndicatorValue / 3);
+			values.setValue(ROW_COUNT_LOWER_PART, rowIndicatorValue % 3);
 			break;
 		case 2:
-			barcodeColumnCount.setValue(rowIndicatorValue + 1);
+			values.setValue(COLUMN_COUNT, rowIndicatorValue + 1);
 			break;
 		}
 	}
 	// Maybe we should check if we have ambiguous values?
-	auto cc = barcodeColumnCount.value();
-	auto rcu = barcodeRowCountUpperPart.value();
-	auto rcl = barcodeRowCountLowerPart.value();
-	auto ec = barcodeECLevel.value();
+	auto cc = values.value(COLUMN_COUNT);
+	auto rcu = values.value(ROW_COUNT_UPPER_PART);
+	auto rcl = values.value(ROW_COUNT_LOWER_PART);
+	auto ec = values.value(EC_LEVEL);
 	if (cc.empty() || rcu.empty() || rcl.empty() || ec.empty() || cc[0] < 1 || rcu[0] + rcl[0] < MIN_ROWS_IN_BARCODE || rcu[0] + rcl[0] > MAX_ROWS_IN_BARCODE) {
 		return false;
 	}
@@ -14,7 +14,6 @@
 #include <array>
 #include <cstdlib>
 #include <limits>
-#include <list>
 #include <vector>
 
 namespace ZXing {
@@ -41,21 +40,16 @@ static const int BARCODE_MIN_HEIGHT = 10;
 * the total variance from the expected pattern proportions across all
 * pattern elements, to the length of the pattern.
 *
-* @param counters observed counters
+* @param view observed counters
 * @param pattern expected pattern
 * @param maxIndividualVariance The most any counter can differ before we give up
 * @return ratio of total variance between counters and pattern compared to total pattern size
 */
-static float
-PatternMatchVariance(const std::vector<int>& counters, const std::vector<int>& pattern, float maxIndividualVariance)
+template <int N, int SUM>
+static float PatternMatchVariance(const PatternView& view, const FixedPattern<N, SUM>& pattern, float maxIndividualVariance)
 {
-	int total = 0;
-	int patternLength = 0;
-	for (size_t i = 0; i < counters.size(); i++) {
-		total += counters[i];
-		patternLength += pattern[i];
-	}
-	if (total < patternLength) {
+	int total = view.sum(N);
+	if (total < SUM) {
 		// If we don't even have one pixel per unit of bar width, assume this
 		// is too small to reliably match, so fail:
 		return std::numeric_limits<float>::max();
@@ -63,12 +57,12 @@ PatternMatchVariance(const std::vector<int>& counters, const std::vector<int>& p
 	// We're going to fake floating-point math in integers. We just need to use more bits.
 	// Scale up patternLength so that intermediate values below like scaledCounter will have
 	// more "significant digits".
-	float unitBarWidth = (float)total / patternLength;
+	float unitBarWidth = (float)total / SUM;
 	maxIndividualVariance *= unitBarWidth;
 
 	float totalVariance = 0.0f;
-	for (size_t x = 0; x < counters.size(); x++) {
-		int counter = counters[x];
+	for (int x = 0; x < N; x++) {
+		int counter = view[x];
 		float scaledPattern = pattern[x] * unitBarWidth;
 		float variance = counter > scaledPattern ? counter - scaledPattern : scaledPattern - counter;
 		if (variance > maxIndividualVariance) {
@@ -79,23 +73,21 @@ PatternMatchVariance(const std::vector<int>& counters, const std::vector<int>& p
 	return totalVariance / total;
 }
 
-
 /**
-* @param matrix row of black/white values to search
+* @param matrix the image to search
 * @param column x position to start search
 * @param row y position to start search
-* @param width the number of pixels to search on this row
+* @param width the search stops at this x position. The last bar of a pattern running up to there ends at width - 1, just
+*              like one ending at the image border.
 * @param pattern pattern of counts of number of black and white pixels that are
 *                 being searched for as a pattern
-* @param counters array of counters, as long as pattern, to re-use
-* @return start/end horizontal offset of guard pattern, as an array of two ints.
+* @param bars buffer for the run-length encoded pixels of the row, to re-use
+* @return start/end horizontal offset of guard pattern
 */
-static bool
-FindGuardPattern(const BitMatrix& matrix, int column, int row, int width, bool whiteFirst, const std::vector<int>& pattern, std::vector<int>& counters, int& startPos, int& endPos)
+template <int N, int SUM>
+static bool FindGuardPattern(BitMatrixView matrix, int column, int row, int width, const FixedPattern<N, SUM>& pattern,
+							 PatternRow& bars, int& startPos, int& endPos)
 {
-	std::fill(counters.begin(), counters.end(), 0);
-	int patternLength = Size(pattern);
-	bool isWhite = whiteFirst;
 	int patternStart = column;
 	int pixelDrift = 0;
 
@@ -103,54 +95,39 @@ FindGuardPattern(const BitMatrix& matrix, int column, int row, int width, bool w
 	while (matrix.get(patternStart, row) && patternStart > 0 && pixelDrift++ < MAX_PIXEL_DRIFT) {
 		patternStart--;
 	}
-	int x = patternStart;
-	int counterPosition = 0;
-	for (; x < width; x++) {
-		bool pixel = matrix.get(x, row);
-		if (pixel != isWhite) {
-			counters[counterPosition]++;
-		}
-		else {
-			if (counterPosition == patternLength - 1) {
-				if (PatternMatchVariance(counters, pattern, MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
-					startPos = patternStart;
-					endPos = x;
-					return true;
-				}
-				patternStart += counters[0] + counters[1];
-				std::copy(counters.begin() + 2, counters.end(), counters.begin());
-				counters[patternLength - 2] = 0;
-				counters[patternLength - 1] = 0;
-				counterPosition--;
-			}
-			else {
-				counterPosition++;
-			}
-			counters[counterPosition] = 1;
-			isWhite = !isWhite;
-		}
-	}
-	if (counterPosition == patternLength - 1) {
-		if (PatternMatchVariance(counters, pattern, MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
+	if (patternStart >= width)
+		return false;
+
+	// a first bar that started left of patternStart is cut off there
+	matrix.getPatternRow(row, patternStart, width, bars);
+	patternStart += bars[0];
+
+	for (auto window = PatternView(bars).subView(0, N); window.isValid(); window.skipPair()) {
+		if (PatternMatchVariance(window, pattern, MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
 			startPos = patternStart;
-			endPos = x - 1;
+			endPos = patternStart + window.sum();
+			if (endPos == width)
+				endPos--;
 			return true;
 		}
+		patternStart += window[0] + window[1];
 	}
 	return false;
 }
 
+template <int N, int SUM>
 static std::array<Nullable<ResultPoint>, 4>&
-FindRowsWithPattern(const BitMatrix& matrix, int height, int width, int startRow, int startColumn, const std::vector<int>& pattern, std::array<Nullable<ResultPoint>, 4>& result)
+FindRowsWithPattern(const BitMatrixView& matrix, int height, int width, int startRow, int startColumn,
+					const FixedPattern<N, SUM>& pattern, std::array<Nullable<ResultPoint>, 4>& result)
 {
 	bool found = false;
 	int startPos, endPos;
 	int minStartRow = startRow;
-	std::vector<int> counters(pattern.size(), 0);
+	PatternRow bars;
 	for (; startRow < height; startRow += ROW_STEP) {
-		if (FindGuardPattern(matrix, startColumn, startRow, width, false, pattern, counters, startPos, endPos)) {
+		if (FindGuardPattern(matrix, startColumn, startRow, width, pattern, bars, startPos, endPos)) {
 			while (startRow > minStartRow + 1) {
-				if (!FindGuardPattern(matrix, startColumn, --startRow, width, false, pattern, counters, startPos, endPos)) {
+				if (!FindGuardPattern(matrix, startColumn, --startRow, width, pattern, bars, startPos, endPos)) {
 					startRow++;
 					break;
 				}
@@ -169,7 +146,10 @@ FindRowsWithPattern(const BitMatrix& matrix, int height, int width, int startRow
 		int previousRowEnd = static_cast<int>(result[1].value().x());
 		for (; stopRow < height; stopRow++) {
 			int startPos, endPos;
-			found = FindGuardPattern(matrix, previousRowStart, stopRow, width, false, pattern, counters, startPos, endPos);
+			// a found pattern ending right of previousRowEnd + MAX_PATTERN_DRIFT is rejected below anyway, so there is
+			// no need to look at the rest of the row.
+			int searchEnd = std::min(width, previousRowEnd + MAX_PATTERN_DRIFT + 1);
+			found = FindGuardPattern(matrix, previousRowStart, stopRow, searchEnd, pattern, bars, startPos, endPos);
 			// a found pattern is only considered to belong to the same barcode if the start and end positions
 			// don't differ too much. Pattern drift should be not bigger than two for consecutive rows. With
 			// a higher number of skipped rows drift could be larger. To keep it simple for now, we allow a slightly
@@ -219,13 +199,13 @@ CopyToResult(std::array<Nullable<ResultPoint>, 8>& result, const std::array<Null
 *           vertices[6] x, y top right codeword area
 *           vertices[7] x, y bottom right codeword area
 */
-static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrix& matrix, int startRow, int startColumn)
+static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrixView& matrix, int startRow, int startColumn)
 {
 	// B S B S B S B S Bar/Space pattern
 	// 11111111 0 1 0 1 0 1 000
-	static const std::vector<int> START_PATTERN = { 8, 1, 1, 1, 1, 1, 1, 3 };
+	constexpr FixedPattern<8, 17> START_PATTERN = { 8, 1, 1, 1, 1, 1, 1, 3 };
 	// 1111111 0 1 000 1 0 1 00 1
-	static const std::vector<int> STOP_PATTERN = { 7, 1, 1, 3, 1, 1, 1, 2, 1 };
+	constexpr FixedPattern<9, 18> STOP_PATTERN = { 7, 1, 1, 3, 1, 1, 1, 2, 1 };
 
 	int width = matrix.width();
 	int height = matrix.height();
@@ -254,12 +234,12 @@ static std::array<Nullable<ResultPoint>, 8> FindVertices(const BitMatrix& matrix
 * @param bitMatrix bit matrix to detect barcodes in
 * @return List of ResultPoint arrays containing the coordinates of found barcodes
 */
-static std::list<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const BitMatrix& bitMatrix, bool multiple)
+static std::vector<std::array<Nullable<ResultPoint>, 8>> DetectBarcode(const BitMatrixView& bitMatrix, bool multiple)
 {
 	int row = 0;
 	int column = 0;
 	bool foundBarcodeInRow = false;
-	std::list<std::array<Nullable<ResultPoint>, 8>> barcodeCoordinates;
+	std::vector<std::array<Nullable<ResultPoint>, 8>> barcodeCoordinates;
 
 	while (row < bitMatrix.height()) {
 		auto vertices = FindVertices(bitMatrix, row, column);
@@ -333,37 +313,25 @@ bool HasStartPattern(const BitMatrix& m, bool rotate90)
 */
 Detector::Result Detector::Detect(const BinaryBitmap& image, bool multiple, bool tryRotate)
 {
-	// construct a 'dummy' shared pointer, just be able to pass it up the call chain in DetectorResult
 	// TODO: reimplement PDF Detector
-	auto binImg = std::shared_ptr<const BitMatrix>(image.getBitMatrix(), [](const BitMatrix*){});
+	auto binImg = image.getBitMatrix();
 	if (!binImg)
 		return {};
 
 	Result result;
 
+	// the rotated images are only views with remapped coordinates, no pixel data is copied
 	for (int rotate90 = 0; rotate90 <= static_cast<int>(tryRotate); ++rotate90) {
 		if (!HasStartPattern(*binImg, rotate90))
 			continue;
 
-		result.rotation = 90 * rotate90;
-		if (rotate90) {
-			auto newBits = std::make_shared<BitMatrix>(binImg->copy());
-			newBits->rotate90();
-			binImg = newBits;
-		}
-
-		result.points = DetectBarcode(*binImg, multiple);
-		result.bits = binImg;
-		if (result.points.empty()) {
-			auto newBits = std::make_shared<BitMatrix>(binImg->copy());
-			newBits->rotate180();
-			result.points = DetectBarcode(*newBits, multiple);
-			result.rotation += 180;
-			result.bits = newBits;
+		for (int rotation : {90 * rotate90, 90 * rotate90 + 180}) {
+			result.bits = BitMatrixView(*binImg, rotation);
+			result.points = DetectBarcode(result.bits, multiple);
+			result.rotation = rotation;
+			if (!result.points.empty())
+				return result;
 		}
-
-		if (!result.points.empty())
-			return result;
 	}
 
 	return {};
@@ -6,16 +6,15 @@
 
 #pragma once
 
+#include "PDFBitMatrixView.h"
 #include "ResultPoint.h"
 #include "ZXNullable.h"
 
-#include <list>
 #include <array>
-#include <memory>
+#include <vector>
 
 namespace ZXing {
 
-class BitMatrix;
 class BinaryBitmap;
 
 namespace Pdf417 {
@@ -33,8 +32,8 @@ class Detector
 public:
 	struct Result
 	{
-		std::shared_ptr<const BitMatrix> bits;
-		std::list<std::array<Nullable<ResultPoint>, 8>> points;
+		BitMatrixView bits;
+		std::vector<std::array<Nullable<ResultPoint>, 8>> points;
 		int rotation = -1;
 	};
 
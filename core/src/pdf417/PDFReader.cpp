@@ -71,11 +71,11 @@ static Barcodes DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotat
 	if (detectorResult.points.empty())
 		return {};
 
-	auto rotate = [res = detectorResult](PointI p) {
+	auto rotate = [&res = detectorResult](PointI p) {
 		switch(res.rotation) {
-		case 90: return PointI(res.bits->height() - p.y - 1, p.x);
-		case 180: return PointI(res.bits->width() - p.x - 1, res.bits->height() - p.y - 1);
-		case 270: return PointI(p.y, res.bits->width() - p.x - 1);
+		case 90: return PointI(res.bits.height() - p.y - 1, p.x);
+		case 180: return PointI(res.bits.width() - p.x - 1, res.bits.height() - p.y - 1);
+		case 270: return PointI(p.y, res.bits.width() - p.x - 1);
 		}
 		return p;
 	};
@@ -83,7 +83,7 @@ static Barcodes DoDecode(const BinaryBitmap& image, bool multiple, bool tryRotat
 	Barcodes res;
 	for (const auto& points : detectorResult.points) {
 		DecoderResult decoderResult =
-			ScanningDecoder::Decode(*detectorResult.bits, points[4], points[5], points[6], points[7],
+			ScanningDecoder::Decode(detectorResult.bits, points[4], points[5], points[6], points[7],
 									GetMinCodewordWidth(points), GetMaxCodewordWidth(points));
 		if (decoderResult.isValid(returnErrors)) {
 			auto customData = std::static_pointer_cast<PDF417CustomData>(decoderResult.customData());
@@ -6,16 +6,17 @@
 
 #include "PDFScanningDecoder.h"
 
-#include "BitMatrix.h"
 #include "DecoderResult.h"
 #include "PDFBarcodeMetadata.h"
 #include "PDFBarcodeValue.h"
+#include "PDFBitMatrixView.h"
 #include "PDFCodewordDecoder.h"
 #include "PDFDetectionResult.h"
 #include "PDFDecoder.h"
 #include "PDFCustomData.h"
 #include "PDFModulusGF.h"
 #include "ZXAlgorithms.h"
+#include "ZXConfig.h"
 #include "ZXTestSupport.h"
 
 #include <cmath>
@@ -29,7 +30,7 @@ static const int MAX_EC_CODEWORDS = 512;
 
 using ModuleBitCountType = std::array<int, CodewordDecoder::BARS_IN_MODULE>;
 
-static int AdjustCodewordStartColumn(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int codewordStartColumn, int imageRow)
+static int AdjustCodewordStartColumn(BitMatrixView image, int minColumn, int maxColumn, bool leftToRight, int codewordStartColumn, int imageRow)
 {
 	int correctedStartColumn = codewordStartColumn;
 	int increment = leftToRight ? -1 : 1;
@@ -48,7 +49,7 @@ static int AdjustCodewordStartColumn(const BitMatrix& image, int minColumn, int
 	return correctedStartColumn;
 }
 
-static bool GetModuleBitCount(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, ModuleBitCountType& moduleBitCount)
+static bool GetModuleBitCount(BitMatrixView image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, ModuleBitCountType& moduleBitCount)
 {
 	int imageColumn = startColumn;
 	size_t moduleNumber = 0;
@@ -105,7 +106,7 @@ static int GetCodewordBucketNumber(int codeword)
 	return GetCodewordBucketNumber(GetBitCountForCodeword(codeword));
 }
 
-static Nullable<Codeword> DetectCodeword(const BitMatrix& image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, int minCodewordWidth, int maxCodewordWidth)
+static Nullable<Codeword> DetectCodeword(BitMatrixView image, int minColumn, int maxColumn, bool leftToRight, int startColumn, int imageRow, int minCodewordWidth, int maxCodewordWidth)
 {
 	startColumn = AdjustCodewordStartColumn(image, minColumn, maxColumn, leftToRight, startColumn, imageRow);
 	// we usually know fairly exact now how long a codeword is. We should provide minimum and maximum expected length
@@ -156,7 +157,7 @@ static Nullable<Codeword> DetectCodeword(const BitMatrix& image, int minColumn,
 	return nullptr;
 }
 
-static DetectionResultColumn GetRowIndicatorColumn(const BitMatrix& image, const BoundingBox& boundingBox, const ResultPoint& startPoint, bool leftToRight, int minCodewordWidth, int maxCodewordWidth)
+static DetectionResultColumn GetRowIndicatorColumn(BitMatrixView image, const BoundingBox& boundingBox, const ResultPoint& startPoint, bool leftToRight, int minCodewordWidth, int maxCodewordWidth)
 {
 	DetectionResultColumn rowIndicatorColumn(boundingBox, leftToRight ? DetectionResultColumn::RowIndicator::Left : DetectionResultColumn::RowIndicator::Right);
 	for (int i = 0; i < 2; i++) {
@@ -305,13 +306,30 @@ static int GetStartColumn(const DetectionResult& detectionResult, int barcodeCol
 	return leftToRight ? detectionResult.getBoundingBox().value().minX() : detectionResult.getBoundingBox().value().maxX();
 }
 
-static std::vector<std::vector<BarcodeValue>> CreateBarcodeMatrix(DetectionResult& detectionResult)
+/**
+* The votes for the codeword values in the barcode matrix: barcodeRowCount() rows x (barcodeColumnCount() + 2) columns,
+* including the row indicator columns.
+*/
+class BarcodeMatrix : public BarcodeValues
 {
-	std::vector<std::vector<BarcodeValue>> barcodeMatrix(detectionResult.barcodeRowCount());
-	for (auto& row : barcodeMatrix) {
-		row.resize(detectionResult.barcodeColumnCount() + 2);
+	int _columns = 0;
+
+public:
+	void init(int rows, int columns)
+	{
+		_columns = columns;
+		BarcodeValues::init(rows * columns);
 	}
 
+	void setValue(int row, int column, int value) { BarcodeValues::setValue(row * _columns + column, value); }
+	void value(int row, int column, std::vector<int>& result) const { BarcodeValues::value(row * _columns + column, result); }
+};
+
+static void CreateBarcodeMatrix(DetectionResult& detectionResult, BarcodeMatrix& barcodeMatrix)
+{
+	const int rowCount = detectionResult.barcodeRowCount();
+	barcodeMatrix.init(rowCount, detectionResult.barcodeColumnCount() + 2);
+
 	int column = 0;
 	for (auto& resultColumn : detectionResult.allColumns()) {
 		if (resultColumn != nullptr) {
@@ -319,18 +337,17 @@ static std::vector<std::vector<BarcodeValue>> CreateBarcodeMatrix(DetectionResul
 				if (codeword != nullptr) {
 					int rowNumber = codeword.value().rowNumber();
 					if (rowNumber >= 0) {
-						if (rowNumber >= Size(barcodeMatrix)) {
+						if (rowNumber >= rowCount) {
 							// We have more rows than the barcode metadata allows for, ignore them.
 							continue;
 						}
-						barcodeMatrix[rowNumber][column].setValue(codeword.value().value());
+						barcodeMatrix.setValue(rowNumber, column, codeword.value().value());
 					}
 				}
 			}
 		}
 		column++;
 	}
-	return barcodeMatrix;
 }
 
 static int GetNumberOfECCodeWords(int barcodeECLevel)
@@ -338,20 +355,21 @@ static int GetNumberOfECCodeWords(int barcodeECLevel)
 	return 2 << barcodeECLevel;
 }
 
-static bool AdjustCodewordCount(const DetectionResult& detectionResult, std::vector<std::vector<BarcodeValue>>& barcodeMatrix)
+static bool AdjustCodewordCount(const DetectionResult& detectionResult, BarcodeMatrix& barcodeMatrix)
 {
-	auto numberOfCodewords = barcodeMatrix[0][1].value();
+	std::vector<int> numberOfCodewords;
+	barcodeMatrix.value(0, 1, numberOfCodewords);
 	int calculatedNumberOfCodewords = detectionResult.barcodeColumnCount() * detectionResult.barcodeRowCount() - GetNumberOfECCodeWords(detectionResult.barcodeECLevel());
 	if (calculatedNumberOfCodewords < 1 || calculatedNumberOfCodewords > CodewordDecoder::MAX_CODEWORDS_IN_BARCODE)
 		calculatedNumberOfCodewords = 0;
 	if (numberOfCodewords.empty()) {
 		if (!calculatedNumberOfCodewords)
 			return false;
-		barcodeMatrix[0][1].setValue(calculatedNumberOfCodewords);
+		barcodeMatrix.setValue(0, 1, calculatedNumberOfCodewords);
 	}
 	else if (calculatedNumberOfCodewords && numberOfCodewords[0] != calculatedNumberOfCodewords) {
 		// The calculated one is more reliable as it is derived from the row indicator columns
-		barcodeMatrix[0][1].setValue(calculatedNumberOfCodewords);
+		barcodeMatrix.setValue(0, 1, calculatedNumberOfCodewords);
 	}
 	return true;
 }
@@ -644,7 +662,9 @@ static DecoderResult CreateDecoderResultFromAmbiguousValues(int ecLevel, std::ve
 
 static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 {
-	auto barcodeMatrix = CreateBarcodeMatrix(detectionResult);
+	// the vote storage is reused for all symbols decoded on this thread
+	ZX_THREAD_LOCAL BarcodeMatrix barcodeMatrix;
+	CreateBarcodeMatrix(detectionResult, barcodeMatrix);
 	if (!AdjustCodewordCount(detectionResult, barcodeMatrix)) {
 		return {};
 	}
@@ -652,9 +672,10 @@ static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 	std::vector<int> codewords(detectionResult.barcodeRowCount() * detectionResult.barcodeColumnCount(), 0);
 	std::vector<std::vector<int>> ambiguousIndexValues;
 	std::vector<int> ambiguousIndexesList;
+	std::vector<int> values;
 	for (int row = 0; row < detectionResult.barcodeRowCount(); row++) {
 		for (int column = 0; column < detectionResult.barcodeColumnCount(); column++) {
-			auto values = barcodeMatrix[row][column + 1].value();
+			barcodeMatrix.value(row, column + 1, values);
 			int codewordIndex = row * detectionResult.barcodeColumnCount() + column;
 			if (values.empty()) {
 				erasures.push_back(codewordIndex);
@@ -678,7 +699,7 @@ static DecoderResult CreateDecoderResult(DetectionResult& detectionResult)
 // This approach also allows detecting more details about the barcode, e.g. if a bar type (white or black) is wider
 // than it should be. This can happen if the scanner used a bad blackpoint.
 DecoderResult
-ScanningDecoder::Decode(const BitMatrix& image, const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
+ScanningDecoder::Decode(const BitMatrixView& image, const Nullable<ResultPoint>& imageTopLeft, const Nullable<ResultPoint>& imageBottomLeft,
 	const Nullable<ResultPoint>& imageTopRight, const Nullable<ResultPoint>& imageBottomRight,
 	int minCodewordWidth, int maxCodewordWidth)
 {
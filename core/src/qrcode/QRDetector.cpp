@@ -25,6 +25,7 @@
 #include <cstdlib>
 #include <iterator>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -49,7 +50,37 @@ PatternView FindPattern(const PatternView& view)
 	});
 }
 
-std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+// Search one row for finder patterns and append them to res
+static void FindFinderPatternsInRow(const BitMatrix& image, int y, const PatternRow& row, std::vector<ConcentricPattern>& res)
+{
+	PatternView next = row;
+
+	while (next = FindPattern(next), next.isValid()) {
+		PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
+
+		// make sure p is not 'inside' an already found pattern area
+		if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
+			log(p);
+			auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p,
+														next.sum() * 3); // 3 for very skewed samples
+			if (pattern) {
+				log(*pattern, 3);
+				log(*pattern + PointF(.2, 0), 3);
+				log(*pattern - PointF(.2, 0), 3);
+				log(*pattern + PointF(0, .2), 3);
+				log(*pattern - PointF(0, .2), 3);
+				assert(image.get(pattern->x, pattern->y));
+				res.push_back(*pattern);
+			}
+		}
+
+		next.skipPair();
+		next.skipPair();
+		next.extend();
+	}
+}
+
+ConcentricRowScan FinderPatternRowScan(const BitMatrix& image, bool tryHarder)
 {
 	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
 	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
@@ -63,55 +94,29 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 	if (skip < MIN_SKIP || tryHarder)
 		skip = MIN_SKIP;
 
-	std::vector<ConcentricPattern> res;
-	[[maybe_unused]] int N = 0;
-	PatternRow row;
-
-	for (int y = skip - 1; y < height; y += skip) {
-		GetPatternRow(image, y, row, false);
-		PatternView next = row;
-
-		while (next = FindPattern(next), next.isValid()) {
-			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
-
-			// make sure p is not 'inside' an already found pattern area
-			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
-				log(p);
-				N++;
-				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p,
-															next.sum() * 3); // 3 for very skewed samples
-				if (pattern) {
-					log(*pattern, 3);
-					log(*pattern + PointF(.2, 0), 3);
-					log(*pattern - PointF(.2, 0), 3);
-					log(*pattern + PointF(0, .2), 3);
-					log(*pattern - PointF(0, .2), 3);
-					assert(image.get(pattern->x, pattern->y));
-					res.push_back(*pattern);
-				}
-			}
-
-			next.skipPair();
-			next.skipPair();
-			next.extend();
-		}
-	}
-
-	printf("FPs?  : %d\n", N);
+	return {skip - 1, height, skip, FindFinderPatternsInRow};
+}
 
+std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+{
+	auto res = std::move(ScanRowsForConcentricPatterns(image, {FinderPatternRowScan(image, tryHarder)}).front());
+	printf("FPs   : %d\n", Size(res));
 	return res;
 }
 
 /**
  * @brief GenerateFinderPatternSets
  * @param patterns list of ConcentricPattern objects, i.e. found finder pattern squares
+ * @param maxSymbols maximum number of symbols to be read (0 means unlimited), see ReaderOptions::maxNumberOfSymbols
  * @return list of plausible finder pattern sets, sorted by decreasing plausibility
  */
-FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
+FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns, int maxSymbols)
 {
 	std::sort(patterns.begin(), patterns.end(), [](const auto& a, const auto& b) { return a.size < b.size; });
 
-	auto sets            = std::multimap<double, FinderPatternSet>();
+	// sorted by d (see below) and by size for equal d, which prefers the actual symbols over the equally perfect but
+	// larger triangles formed by the finder patterns of neighboring symbols in a (synthetic) grid of symbols
+	auto sets            = std::multimap<std::pair<double, double>, FinderPatternSet>();
 	auto squaredDistance = [](const auto* a, const auto* b) {
 		// The scaling of the distance based on the b/a size ratio is a very coarse compensation for the shortening effect of
 		// the camera projection on slanted symbols. The fact that the size of the finder pattern is proportional to the
@@ -124,17 +129,64 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 	const double cosUpper = std::cos(60. / 180 * 3.1415); // TODO: use c++20 std::numbers::pi_v
 	const double cosLower = std::cos(120. / 180 * 3.1415);
 
+	// The module count estimation below rejects every set where (distAB + distBC) > MAX_DIST_PER_SIZE * (a + b + c).size.
+	// Since b and c are at most twice as big as a (see below), no pattern further than MAX_DIST_PER_SIZE * 5 * a.size
+	// away from a can be part of a set with a. The patterns are put into a grid of buckets per size class
+	// [2^n, 2^(n+1)) with a cell size of that distance limit for the smallest member of the class. Only the patterns
+	// in the neighboring cells of the same and the next bigger size class need to be considered as set members.
+	constexpr double MAX_DIST_PER_SIZE = (177 * 1.5 - 7) * 2 / (3 * 7.);
+	auto sizeClass = [](int size) { return BitHacks::HighestBitSet(std::max(size, 1)); };
+	auto cellSize = [](int sizeClass) { return MAX_DIST_PER_SIZE * 5 * (1 << sizeClass) + 1; };
+	auto bucketKey = [](int sizeClass, int cx, int cy) {
+		return (uint64_t(sizeClass) << 48) | (uint64_t(uint16_t(cx)) << 16) | uint64_t(uint16_t(cy));
+	};
+
 	int nbPatterns = Size(patterns);
+	std::unordered_map<uint64_t, std::vector<int>> buckets;
+	for (int i = 0; i < nbPatterns; ++i) {
+		int sc = sizeClass(patterns[i].size);
+		buckets[bucketKey(sc, int(patterns[i].x / cellSize(sc)), int(patterns[i].y / cellSize(sc)))].push_back(i);
+	}
+
+	// On images with hundreds of symbols, the maxDist range (which accounts for version 40 symbols) contains a large
+	// fraction of all patterns, making the loop below cubic in the number of symbols. In that case only the nearest
+	// candidates are considered, the other two patterns of a symbol are among them for any sensible quiet zone. This is
+	// lossy: the partners of a big symbol may be further away than many (false positive) patterns, so the limit only
+	// applies to multi-symbol scans with more patterns than the exhaustive search can handle in reasonable time.
+	constexpr int MAX_CANDIDATES = 64;
+	constexpr int MIN_PATTERNS_FOR_CANDIDATE_LIMIT = 256;
+	const bool limitCandidates = maxSymbols != 1 && nbPatterns > MIN_PATTERNS_FOR_CANDIDATE_LIMIT;
+	const int setSizeLimit = std::max(256, 2 * nbPatterns);
+	std::vector<int> candidates;
 	for (int i = 0; i < nbPatterns - 2; i++) {
-		for (int j = i + 1; j < nbPatterns - 1; j++) {
-			for (int k = j + 1; k < nbPatterns - 0; k++) {
-				const auto* a = &patterns[i];
-				const auto* b = &patterns[j];
-				const auto* c = &patterns[k];
-				// if the pattern sizes are too different to be part of the same symbol, skip this
-				// and the rest of the innermost loop (sorted list)
-				if (c->size > a->size * 2)
-					break;
+		const auto& pa = patterns[i];
+		const double maxDist = MAX_DIST_PER_SIZE * 5 * pa.size + 1;
+
+		// collect all bigger patterns (in sort order) that are close enough and at most twice as big as pa
+		candidates.clear();
+		for (int sc = sizeClass(pa.size), range = 2; sc <= sizeClass(pa.size) + 1; ++sc, --range) {
+			int cx = int(pa.x / cellSize(sc)), cy = int(pa.y / cellSize(sc));
+			for (int y = cy - range; y <= cy + range; ++y)
+				for (int x = cx - range; x <= cx + range; ++x)
+					if (auto bucket = buckets.find(bucketKey(sc, x, y)); bucket != buckets.end())
+						for (int j : bucket->second)
+							if (j > i && patterns[j].size <= pa.size * 2 && distance(pa, patterns[j]) <= maxDist)
+								candidates.push_back(j);
+		}
+		if (limitCandidates && Size(candidates) > MAX_CANDIDATES) {
+			auto closer = [&](int j, int k) { return distance(pa, patterns[j]) < distance(pa, patterns[k]); };
+			std::nth_element(candidates.begin(), candidates.begin() + MAX_CANDIDATES, candidates.end(), closer);
+			candidates.resize(MAX_CANDIDATES);
+		}
+		// keep the original processing order to get the sets of the exhaustive search (with identical order for equal d),
+		// unless the candidates were limited above
+		std::sort(candidates.begin(), candidates.end());
+
+		for (int j = 0; j < Size(candidates) - 1; j++) {
+			for (int k = j + 1; k < Size(candidates); k++) {
+				const auto* a = &pa;
+				const auto* b = &patterns[candidates[j]];
+				const auto* c = &patterns[candidates[k]];
 
 				// Orders the three points in an order [A,B,C] such that AB is less than AC
 				// and BC is less than AC, and the angle between BC and BA is less than 180 degrees.
@@ -182,12 +234,11 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 				if (cross(*c - *b, *a - *b) < 0)
 					std::swap(a, c);
 
-				// arbitrarily limit the number of potential sets
-				// (this has performance implications while limiting the maximal number of detected symbols)
-				const auto setSizeLimit = 256;
-				if (sets.size() < setSizeLimit || sets.crbegin()->first > d) {
-					sets.emplace(d, FinderPatternSet{*a, *b, *c});
-					if (sets.size() > setSizeLimit)
+				// arbitrarily limit the number of potential sets, scaled with the number of patterns so that the limit
+				// does not cap the number of detectable symbols on images with many of them
+				if (auto key = std::pair(d, distAC2); Size(sets) < setSizeLimit || sets.crbegin()->first > key) {
+					sets.emplace(key, FinderPatternSet{*a, *b, *c});
+					if (Size(sets) > setSizeLimit)
 						sets.erase(std::prev(sets.end()));
 				}
 			}
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "ConcentricFinder.h"
+#include "ConcentricScan.h"
 #include "DetectorResult.h"
 
 #include <vector>
@@ -27,8 +28,9 @@ struct FinderPatternSet
 using FinderPatterns = std::vector<ConcentricPattern>;
 using FinderPatternSets = std::vector<FinderPatternSet>;
 
+ConcentricRowScan FinderPatternRowScan(const BitMatrix& image, bool tryHarder);
 FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder);
-FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns);
+FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns, int maxSymbols = 0);
 
 DetectorResult SampleQR(const BitMatrix& image, const FinderPatternSet& fp);
 DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp);
@@ -286,17 +286,13 @@ void TerminateBits(int numDataBytes, BitArray& bits)
 		throw std::invalid_argument("data bits cannot fit in the QR Code" + std::to_string(bits.size()) + " > "
 									+ std::to_string(capacity));
 	}
-	for (int i = 0; i < 4 && bits.size() < capacity; ++i) {
-		bits.appendBit(false);
-	}
+	bits.reserve(capacity);
+	bits.appendBits(0, std::min(4, capacity - bits.size()));
 	// Append termination bits. See 8.4.8 of JISX0510:2004 (p.24) for details.
 	// If the last byte isn't 8-bit aligned, we'll add padding bits.
 	int numBitsInLastByte = bits.size() & 0x07;
-	if (numBitsInLastByte > 0) {
-		for (int i = numBitsInLastByte; i < 8; i++) {
-			bits.appendBit(false);
-		}
-	}
+	if (numBitsInLastByte > 0)
+		bits.appendBits(0, 8 - numBitsInLastByte);
 	// If we have more space, we'll fill the space with padding patterns defined in 8.4.9 (p.24).
 	int numPaddingBytes = numDataBytes - bits.sizeInBytes();
 	for (int i = 0; i < numPaddingBytes; ++i) {
@@ -371,12 +367,8 @@ void GetNumDataBytesAndNumECBytesForBlockID(int numTotalBytes, int numDataBytes,
 ZXING_EXPORT_TEST_ONLY
 void GenerateECBytes(const ByteArray& dataBytes, int numEcBytes, ByteArray& ecBytes)
 {
-	std::vector<int> message(dataBytes.size() + numEcBytes, 0);
-	std::copy(dataBytes.begin(), dataBytes.end(), message.begin());
-	ReedSolomonEncode(GenericGF::QRCodeField256(), message, numEcBytes);
-
 	ecBytes.resize(numEcBytes);
-	std::transform(message.end() - numEcBytes, message.end(), ecBytes.begin(), [](auto c) { return narrow_cast<uint8_t>(c); });
+	ReedSolomonEncode(GenericGF::QRCodeField256(), dataBytes.data(), Size(dataBytes), ecBytes.data(), numEcBytes);
 }
 
 
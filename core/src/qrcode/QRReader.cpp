@@ -9,6 +9,7 @@
 
 #include "BinaryBitmap.h"
 #include "ConcentricFinder.h"
+#include "ConcentricScan.h"
 #include "ReaderOptions.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
@@ -17,6 +18,7 @@
 #include "QRDetector.h"
 #include "Barcode.h"
 
+#include <set>
 #include <utility>
 
 namespace ZXing::QRCode {
@@ -77,19 +79,21 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	LogMatrixWriter lmw(log, *binImg, 5, "qr-log.pnm");
 #endif
 	
-	auto allFPs = FindFinderPatterns(*binImg, _opts.tryHarder());
+	auto allFPs = FindConcentricPatterns(image, BarcodeFormat::QRCode, _opts);
 
 #ifdef PRINT_DEBUG
 	printf("allFPs: %d\n", Size(allFPs));
 #endif
 
-	std::vector<ConcentricPattern> usedFPs;
+	// the finder patterns of successfully decoded symbols, a sorted set keeps the lookup fast with thousands of symbols
+	std::set<std::pair<double, double>> usedFPs;
+	auto isUsed = [&usedFPs](const PointF& fp) { return usedFPs.count({fp.x, fp.y}) > 0; };
 	Barcodes res;
 	
 	if (_opts.hasFormat(BarcodeFormat::QRCode)) {
-		auto allFPSets = GenerateFinderPatternSets(allFPs);
+		auto allFPSets = GenerateFinderPatternSets(allFPs, maxSymbols);
 		for (const auto& fpSet : allFPSets) {
-			if (Contains(usedFPs, fpSet.bl) || Contains(usedFPs, fpSet.tl) || Contains(usedFPs, fpSet.tr))
+			if (isUsed(fpSet.bl) || isUsed(fpSet.tl) || isUsed(fpSet.tr))
 				continue;
 
 			logFPSet(fpSet);
@@ -98,9 +102,8 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 			if (detectorResult.isValid()) {
 				auto decoderResult = Decode(detectorResult.bits());
 				if (decoderResult.isValid()) {
-					usedFPs.push_back(fpSet.bl);
-					usedFPs.push_back(fpSet.tl);
-					usedFPs.push_back(fpSet.tr);
+					for (const auto& fp : {fpSet.bl, fpSet.tl, fpSet.tr})
+						usedFPs.insert({fp.x, fp.y});
 				}
 				if (decoderResult.isValid(_opts.returnErrors())) {
 					res.emplace_back(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::QRCode);
@@ -113,7 +116,7 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	
 	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
 		for (const auto& fp : allFPs) {
-			if (Contains(usedFPs, fp))
+			if (isUsed(fp))
 				continue;
 
 			auto detectorResult = SampleMQR(*binImg, fp);
@@ -132,7 +135,7 @@ Barcodes Reader::decode(const BinaryBitmap& image, int maxSymbols) const
 	if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
 		// TODO proper
 		for (const auto& fp : allFPs) {
-			if (Contains(usedFPs, fp))
+			if (isUsed(fp))
 				continue;
 
 			auto detectorResult = SampleRMQR(*binImg, fp);
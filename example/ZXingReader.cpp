@@ -191,7 +191,7 @@ int main(int argc, char* argv[])
 {
 	ReaderOptions options;
 	CLI cli;
-	Barcodes allBarcodes;
+	StructuredAppendAssembler sequences;
 	int ret = 0;
 
 	options.setTextMode(TextMode::HRI);
@@ -227,12 +227,10 @@ int main(int argc, char* argv[])
 		if (barcodes.empty())
 			barcodes.emplace_back();
 
-		allBarcodes.insert(allBarcodes.end(), barcodes.begin(), barcodes.end());
-		if (filePath == cli.filePaths.back()) {
-			auto merged = MergeStructuredAppendSequences(allBarcodes);
-			// report all merged sequences as part of the last file to make the logic not overly complicated here
-			barcodes.insert(barcodes.end(), std::make_move_iterator(merged.begin()), std::make_move_iterator(merged.end()));
-		}
+		// report a merged sequence as part of the file that completes it
+		for (int i = 0, n = Size(barcodes); i < n; ++i)
+			if (auto merged = sequences.add(barcodes[i]); merged.isValid())
+				barcodes.push_back(std::move(merged));
 
 		for (auto&& barcode : barcodes) {
 
@@ -475,11 +475,17 @@ int runBlackBoxTests(const fs::path& testPathPrefix, const std::set<std::string>
 		});
 
 		runTests("maxicode-1", "MaxiCode", 9, {
-			{ 9, 9, 0 },
+			{ 9, 9, 0   },
+			{ 6, 6, 90  },
+			{ 6, 6, 180 },
+			{ 6, 6, 270 },
 		});
 
 		runTests("maxicode-2", "MaxiCode", 4, {
-			{ 0, 0, 0 },
+			{ 4, 4, 0   },
+			{ 4, 4, 90  },
+			{ 4, 4, 180 },
+			{ 4, 4, 270 },
 		});
 
 		runTests("upca-1", "UPC-A", 12, {
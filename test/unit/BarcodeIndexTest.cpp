@@ -0,0 +1,132 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BarcodeIndex.h"
+
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+static Barcode Line(int y, int xStart, int xStop, BarcodeFormat format = BarcodeFormat::Code128)
+{
+	return Barcode("ABC", y, xStart, xStop, format, {});
+}
+
+// a symbol like the ODReader reports it: lineCount lines from (x, y) to (x + length, y + height), optionally rotated
+// by 90 degree the same way the ODReader does it for the tryRotate scan
+static Barcode Symbol(int x, int y, int length, int height, int lineCount, bool rotate)
+{
+	auto res = Line(y, x, x + length);
+	auto points = res.position();
+	points[2] += PointI{0, height};
+	points[3] += PointI{0, height};
+	if (rotate)
+		for (auto& p : points)
+			p = {p.y, 2000 - p.x - 1};
+	res.setPosition(points);
+	for (int i = 0; i < lineCount; ++i)
+		IncrementLineCount(res);
+	return res;
+}
+
+TEST(BarcodeIndexTest, Candidates)
+{
+	Barcodes list;
+	BarcodeIndex index(4000);
+	for (int y = 0; y < 3000; y += 100)
+		for (int x = 0; x < 4000; x += 400) {
+			list.push_back(Line(y, x, x + 300));
+			index.insert(Size(list) - 1, list.back());
+		}
+
+	// every barcode that compares equal needs to be among the candidates
+	for (auto query : {Line(1010, 1210, 1510), Line(1000, 1600, 1900), Line(1099, 3700, 3999), Line(-5, -10, 200)}) {
+		auto& candidates = index.candidates(query);
+		EXPECT_LT(Size(candidates), Size(list) / 10);
+		for (int i = 0; i < Size(list); ++i)
+			if (list[i] == query || query == list[i]) {
+				EXPECT_TRUE(Contains(candidates, i)) << i;
+			}
+	}
+
+	EXPECT_TRUE(index.candidates(Line(1000, 1600, 1900, BarcodeFormat::EAN13)).empty());
+}
+
+TEST(BarcodeIndexTest, UpdateAndOverlap)
+{
+	Barcodes list = {Line(100, 100, 400), Line(100, 1000, 1300)};
+	BarcodeIndex index(2000);
+	for (int i = 0; i < Size(list); ++i)
+		index.insert(i, list[i]);
+
+	EXPECT_EQ(index.overlapping(Line(100, 1200, 1250).position()), std::vector<int>{1});
+	EXPECT_TRUE(index.overlapping(Line(100, 500, 900).position()).empty());
+
+	list[0].setPosition({PointI{100, 100}, {700, 100}, {700, 100}, {100, 100}});
+	index.insert(0, list[0]);
+	EXPECT_EQ(index.overlapping(Line(100, 500, 900).position()), std::vector<int>{0});
+	EXPECT_EQ(index.overlapping(Line(100, 600, 1100).position()), (std::vector<int>{0, 1}));
+}
+
+TEST(BarcodeIndexTest, NoFalseNegatives)
+{
+	PseudoRandom rand(42);
+	// with few symbols, the index checks all bounding boxes, with many it uses the hash grid
+	for (int nbSymbols : {20, 500}) {
+		for (bool rotate : {false, true}) {
+			Barcodes list;
+			BarcodeIndex index(2000);
+			for (int i = 0; i < nbSymbols; ++i) {
+				list.push_back(Symbol(rand.next(-50, 1800), rand.next(-50, 1950), rand.next(50, 300), rand.next(0, 80),
+									  rand.next(1, 3), rotate));
+				index.insert(Size(list) - 1, list.back());
+			}
+
+			// query lines close to the listed ones to get a reasonable number of matches
+			int nbMatches = 0;
+			for (int i = 0; i < 2000; ++i) {
+				auto& ref = list[rand.next(0, nbSymbols - 1)];
+				auto bb = BoundingBox(ref.position());
+				int length = std::max(bb.bottomRight().x - bb.topLeft().x, bb.bottomRight().y - bb.topLeft().y);
+				int x = (rotate ? 2000 - 1 - bb.bottomRight().y : bb.topLeft().x) + rand.next(-length / 2, length / 2);
+				int y = (rotate ? bb.topLeft().x : bb.topLeft().y) + rand.next(-length, length);
+				auto query = Symbol(x, y, length * rand.next(70, 130) / 100, rand.next(0, 40), rand.next(1, 2), rotate);
+
+				auto& candidates = index.candidates(query);
+				for (int j = 0; j < Size(list); ++j)
+					if (list[j] == query || query == list[j]) {
+						++nbMatches;
+						EXPECT_TRUE(Contains(candidates, j)) << "symbol " << j << ", nbSymbols " << nbSymbols;
+					}
+			}
+			EXPECT_GT(nbMatches, 200);
+		}
+	}
+}
+
+TEST(BarcodeIndexTest, GrowingSymbol)
+{
+	// enough symbols to use the hash grid
+	Barcodes list;
+	BarcodeIndex index(2000);
+	for (int i = 0; i < 100; ++i) {
+		list.push_back(Line(1900, i * 10, i * 10 + 5));
+		index.insert(i, list.back());
+	}
+
+	// a symbol growing line by line over many cells, like a tall symbol merging more and more lines
+	list.push_back(Symbol(100, 100, 300, 0, 1, false));
+	int i = Size(list) - 1;
+	for (int height = 0; height < 1500; height += 10) {
+		list[i] = Symbol(100 - height / 10, 100, 300 + height / 5, height, 1, false);
+		index.insert(i, list[i]);
+		// the cells already referencing it are not added again
+		EXPECT_EQ(index.overlapping(Line(100 + height, 150, 160).position()), std::vector<int>{i}) << height;
+	}
+	EXPECT_EQ(index.overlapping(Line(1000, 80, 90).position()), std::vector<int>{i});
+	EXPECT_TRUE(index.overlapping(Line(1000, 600, 700).position()).empty());
+}
@@ -0,0 +1,99 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Barcode.h"
+#include "ReadBarcode.h"
+#include "oned/ODCode128Patterns.h"
+
+#include "gtest/gtest.h"
+#include <utility>
+#include <vector>
+
+using namespace ZXing;
+
+TEST(BarcodeTest, TextView)
+{
+	Barcode barcode("A\tB", 10, 0, 100, BarcodeFormat::Code128, {});
+
+	// text() works with and without a cached textView()
+	EXPECT_EQ(barcode.text(TextMode::Escaped), "A<HT>B");
+	auto view = barcode.textView(TextMode::Escaped);
+	EXPECT_EQ(view, "A<HT>B");
+	EXPECT_EQ(barcode.text(TextMode::Escaped), view);
+
+	// the cache keeps one entry per TextMode and the views stay valid
+	EXPECT_EQ(barcode.textView(TextMode::Plain), "A\tB");
+	EXPECT_EQ(barcode.textView(TextMode::Escaped).data(), view.data());
+	EXPECT_EQ(barcode.textView(TextMode::Hex), "41 09 42");
+
+	// copies have their own cache
+	auto copy = barcode;
+	EXPECT_EQ(copy.textView(TextMode::Escaped), "A<HT>B");
+	EXPECT_NE(copy.textView(TextMode::Escaped).data(), view.data());
+}
+
+// a Code 128 symbol (start code, data values, the check digit gets added) with 2 pixel wide modules
+static std::vector<uint8_t> Code128(const std::vector<int>& values, int& width, int height = 20)
+{
+	std::vector<int> codes = values;
+	int checksum = codes[0];
+	for (int i = 1; i < Size(codes); ++i)
+		checksum += i * codes[i];
+	codes.push_back(checksum % 103);
+
+	std::vector<uint8_t> row(2 * 10, 255); // quiet zone
+	auto append = [&row](int modules, bool black) { row.insert(row.end(), 2 * modules, black ? 0 : 255); };
+	for (int code : codes)
+		for (int i = 0; i < 6; ++i)
+			append(OneD::Code128::CODE_PATTERNS[code][i], i % 2 == 0);
+	for (int i = 0; i < 7; ++i) // stop pattern
+		append("2331112"[i] - '0', i % 2 == 0);
+	append(10, false);
+
+	width = Size(row);
+	std::vector<uint8_t> img;
+	for (int y = 0; y < height; ++y)
+		img.insert(img.end(), row.begin(), row.end());
+	return img;
+}
+
+TEST(BarcodeTest, TextMode)
+{
+	int width;
+	auto img = Code128({103, 33, 73, 34}, width); // Code Set A "A<HT>B"
+	ImageView iv(img.data(), width, 20, ImageFormat::Lum);
+
+	// the TextMode of the ReaderOptions is the default for text() and textView()
+	auto barcode = ReadBarcode(iv, ReaderOptions().setFormats(BarcodeFormat::Code128).setTextMode(TextMode::Escaped));
+	ASSERT_TRUE(barcode.isValid());
+	EXPECT_EQ(barcode.text(), "A<HT>B");
+	EXPECT_EQ(barcode.textView(), "A<HT>B");
+	EXPECT_EQ(barcode.text(TextMode::Hex), "41 09 42");
+
+	// copies and moved-to objects keep it
+	auto copy = barcode;
+	EXPECT_EQ(copy.text(), "A<HT>B");
+	auto moved = std::move(copy);
+	EXPECT_EQ(moved.text(), "A<HT>B");
+
+	barcode = ReadBarcode(iv, ReaderOptions().setFormats(BarcodeFormat::Code128).setTextMode(TextMode::Hex));
+	EXPECT_EQ(barcode.text(), "41 09 42");
+	EXPECT_EQ(barcode.textView(), "41 09 42");
+
+	EXPECT_EQ(ReadBarcode(iv, ReaderOptions().setFormats(BarcodeFormat::Code128)).text(), "A\tB");
+}
+
+TEST(BarcodeTest, CharacterSet)
+{
+	int width;
+	auto img = Code128({104, 100, 73}, width); // Code Set B FNC4 'i' = 0xE9
+	ImageView iv(img.data(), width, 20, ImageFormat::Lum);
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTextMode(TextMode::Plain);
+
+	// the character set is applied to the content, independent of the TextMode
+	EXPECT_EQ(ReadBarcode(iv, opts).text(), "\xC3\xA9"); // LATIN SMALL LETTER E WITH ACUTE
+	EXPECT_EQ(ReadBarcode(iv, ReaderOptions(opts).setCharacterSet(CharacterSet::ISO8859_7)).text(), "\xCE\xB9"); // GREEK SMALL LETTER IOTA
+	EXPECT_EQ(ReadBarcode(iv, ReaderOptions(opts).setCharacterSet(CharacterSet::ISO8859_7).setTextMode(TextMode::Hex)).text(), "E9");
+}
@@ -0,0 +1,90 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitArray.h"
+#include "BitArrayUtility.h"
+#include "BitSource.h"
+#include "ByteArray.h"
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+#include <string>
+
+using namespace ZXing;
+
+TEST(BitArrayTest, AppendAndGetBits)
+{
+	PseudoRandom rand(42);
+	BitArray bits;
+	std::string expected;
+	for (int i = 0; i < 200; ++i) {
+		int n = rand.next(0, 64);
+		uint64_t value = (uint64_t(rand.next(0, 0x7fffffff)) << 33) ^ rand.next(0, 0x7fffffff);
+		bits.appendBits(value, n);
+		for (int j = n - 1; j >= 0; --j)
+			expected.push_back((value >> j) & 1 ? 'X' : '.');
+	}
+
+	ASSERT_EQ(bits.size(), Size(expected));
+	EXPECT_EQ(Utility::ToString(bits), expected);
+
+	for (int pos = 0; pos < bits.size(); pos += 13) {
+		int n = std::min(64, bits.size() - pos);
+		uint64_t value = 0;
+		for (int j = 0; j < n; ++j)
+			value = (value << 1) | (expected[pos + j] == 'X');
+		EXPECT_EQ(bits.getBits(pos, n), value) << pos;
+	}
+}
+
+TEST(BitArrayTest, SetAndCompare)
+{
+	auto a = Utility::ParseBitArray("X..X.XX.X..X.X..XX.X..X.X..XX.X..X.X..XX.X..X.X..XX.X..X.X..XX.X..X.X..X");
+	BitArray b(a.size());
+	for (int i = 0; i < a.size(); ++i)
+		b.set(i, a.get(i));
+	EXPECT_EQ(a, b);
+
+	b.set(70, !b.get(70));
+	EXPECT_FALSE(a == b);
+
+	b.bitwiseXOR(a);
+	EXPECT_EQ(Utility::ToString(b), std::string(70, '.') + "X" + std::string(a.size() - 71, '.'));
+
+	EXPECT_THROW(b.get(a.size()), std::out_of_range);
+}
+
+TEST(BitArrayTest, AppendBitArrayAndReverse)
+{
+	auto a = Utility::ParseBitArray("XX.X..XXX.X");
+	auto b = Utility::ParseBitArray(std::string(60, 'X') + "..X.");
+	a.appendBitArray(b);
+	EXPECT_EQ(Utility::ToString(a), "XX.X..XXX.X" + std::string(60, 'X') + "..X.");
+
+	a.reverse();
+	EXPECT_EQ(Utility::ToString(a), ".X.." + std::string(60, 'X') + "X.XXX..X.XX");
+}
+
+TEST(BitArrayTest, ToBytes)
+{
+	auto bits = Utility::ParseBitArray("X.X.X.X.XXXX....X");
+	EXPECT_EQ(bits.toBytes(), ByteArray({0xAA, 0xF0, 0x80}));
+	EXPECT_EQ(bits.toBytes(4, 1), ByteArray({0xAF}));
+}
+
+TEST(BitSourceTest, ReadBits)
+{
+	ByteArray bytes = {0x01, 0x02, 0x03, 0x04, 0x05};
+	BitSource source(bytes);
+	EXPECT_EQ(source.available(), 40);
+	EXPECT_EQ(source.readBits(1), 0);
+	EXPECT_EQ(source.readBits(6), 0);
+	EXPECT_EQ(source.peakBits(3), 4);
+	EXPECT_EQ(source.readBits(3), 4);
+	EXPECT_EQ(source.bitOffset(), 2);
+	EXPECT_EQ(source.readBits(30), 0x02030405 & 0x3fffffff);
+	EXPECT_EQ(source.available(), 0);
+	EXPECT_THROW(source.readBits(1), std::out_of_range);
+}
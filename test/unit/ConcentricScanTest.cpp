@@ -0,0 +1,95 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ConcentricScan.h"
+
+#include "BitMatrix.h"
+#include "ReaderOptions.h"
+#include "ThresholdBinarizer.h"
+#include "aztec/AZDetector.h"
+#include "aztec/AZWriter.h"
+#include "qrcode/QRDetector.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing;
+
+// a QR Code on the left and an Aztec code on the right side of a 600 x 300 pixel image
+static std::vector<uint8_t> CreateImage(int width, int height)
+{
+	std::vector<uint8_t> buf(width * height, 0xFF);
+	auto draw = [&](const BitMatrix& bits, int left) {
+		for (int y = 0; y < bits.height(); ++y)
+			for (int x = 0; x < bits.width(); ++x)
+				if (bits.get(x, y))
+					buf[(25 + y) * width + left + x] = 0;
+	};
+	draw(QRCode::Writer().setMargin(0).encode(L"concentric", 250, 250), 25);
+	draw(Aztec::Writer().setMargin(0).encode(L"concentric", 250, 250), 325);
+	return buf;
+}
+
+TEST(ConcentricScanTest, SinglePassForAllFormats)
+{
+	auto buf = CreateImage(600, 300);
+	ThresholdBinarizer image(ImageView(buf.data(), 600, 300, ImageFormat::Lum));
+	const auto& bits = *image.getBitMatrix();
+
+	auto scans = std::vector{QRCode::FinderPatternRowScan(bits, true), Aztec::FinderPatternRowScan(bits, true)};
+	auto res = ScanRowsForConcentricPatterns(bits, scans);
+	ASSERT_EQ(Size(res), 2);
+	EXPECT_EQ(Size(res[0]), 3);
+	EXPECT_EQ(Size(res[1]), 1);
+
+	// the shared scan finds the same patterns as the individual ones
+	EXPECT_EQ(res[0], QRCode::FindFinderPatterns(bits, true));
+	EXPECT_EQ(res[1], ScanRowsForConcentricPatterns(bits, {scans[1]}).front());
+
+	auto opts = ReaderOptions().setTryHarder(true).setMaxNumberOfSymbols(10);
+	EXPECT_EQ(FindConcentricPatterns(image, BarcodeFormat::QRCode, opts), res[0]);
+	// the Aztec patterns have been found in the same pass
+	EXPECT_TRUE(image.concentricPatternCache().formats.testFlag(BarcodeFormat::Aztec));
+	EXPECT_EQ(FindConcentricPatterns(image, BarcodeFormat::Aztec, opts), res[1]);
+
+	image.invert();
+	EXPECT_TRUE(image.concentricPatternCache().formats.empty());
+}
+
+TEST(ConcentricScanTest, SingleSymbol)
+{
+	auto buf = CreateImage(600, 300);
+	ThresholdBinarizer image(ImageView(buf.data(), 600, 300, ImageFormat::Lum));
+
+	// if only one symbol is requested, the Aztec reader might not get to run, so don't scan for its patterns
+	auto opts = ReaderOptions().setMaxNumberOfSymbols(1);
+	EXPECT_EQ(Size(FindConcentricPatterns(image, BarcodeFormat::QRCode, opts)), 3);
+	EXPECT_FALSE(image.concentricPatternCache().formats.testFlag(BarcodeFormat::Aztec));
+	EXPECT_EQ(Size(FindConcentricPatterns(image, BarcodeFormat::Aztec, opts)), 1);
+}
+
+TEST(ConcentricScanTest, Bands)
+{
+	auto buf = CreateImage(600, 300);
+	ThresholdBinarizer image(ImageView(buf.data(), 600, 300, ImageFormat::Lum));
+	const auto& bits = *image.getBitMatrix();
+
+	auto scans = std::vector{QRCode::FinderPatternRowScan(bits, true), Aztec::FinderPatternRowScan(bits, true)};
+	auto ref = ScanRowsForConcentricPatterns(bits, scans, nullptr, 1);
+	ASSERT_EQ(Size(ref[0]), 3);
+	ASSERT_EQ(Size(ref[1]), 1);
+
+	// with 7 bands, the borders at y = 42, 85, 214 and 257 cut through the QR finder patterns and the ones at y = 128
+	// and 171 through the Aztec bullseye, each of them still has to be reported exactly once
+	for (int nbBands = 2; nbBands <= 8; ++nbBands) {
+		auto res = ScanRowsForConcentricPatterns(bits, scans, nullptr, nbBands);
+		EXPECT_EQ(res, ref) << "nbBands: " << nbBands;
+	}
+
+	// the threads can be turned off
+	EXPECT_EQ(ConcentricScanBands(scans, 1), 1);
+	EXPECT_GE(ConcentricScanBands(scans, 0), 1);
+}
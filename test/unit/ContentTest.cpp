@@ -5,8 +5,10 @@
 
 #include "Content.h"
 #include "ECI.h"
+#include "TextDecoder.h"
 
 #include "gtest/gtest.h"
+#include <tuple>
 
 using namespace ZXing;
 using namespace testing;
@@ -106,3 +108,43 @@ TEST(ContentTest, ECI)
 		EXPECT_EQ(c.bytesECI().asString(), std::string_view("]d4\\000003C:\\\\Test\\000026Täßt"));
 	}
 }
+
+TEST(ContentTest, VerbatimUtf8)
+{
+	// ASCII content is returned as is for all ASCII compatible encodings
+	std::string ascii;
+	for (int i = 1; i < 0x80; ++i)
+		ascii.push_back(static_cast<char>(i));
+	for (auto eci : {ECI::Unknown, ECI::ISO8859_1, ECI::ISO8859_7, ECI::Shift_JIS, ECI::Cp1252, ECI::UTF8, ECI::ASCII,
+					 ECI::Big5, ECI::GB18030, ECI::Binary}) {
+		Content c;
+		if (eci != ECI::Unknown)
+			c.switchEncoding(eci);
+		c.append(ascii);
+		EXPECT_EQ(c.utf8(), ascii) << ToInt(eci);
+	}
+
+	// everything else is converted
+	using namespace std::literals;
+	for (auto [eci, bytes, utf8] : {std::tuple{ECI::ISO8859_1, "A\xE4"sv, "A\xC3\xA4"sv}, {ECI::ISO8859_7, "A\xE1"sv, "A\xCE\xB1"sv},
+									{ECI::Shift_JIS, "A\x82\xA0"sv, "A\xE3\x81\x82"sv}, {ECI::UTF16BE, "\0A\0\xE4"sv, "A\xC3\xA4"sv}}) {
+		Content c;
+		c.switchEncoding(eci);
+		c.append(bytes);
+		EXPECT_EQ(c.utf8(), utf8) << ToInt(eci);
+	}
+
+	{ // valid UTF-8 is returned as is
+		Content c;
+		c.switchEncoding(ECI::UTF8);
+		c.append("\xEF\xBB\xBF" "A\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+		EXPECT_EQ(c.utf8(), "\xEF\xBB\xBF" "A\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+	}
+
+	{ // invalid UTF-8 is converted
+		Content c;
+		c.switchEncoding(ECI::UTF8);
+		c.append("A\xC3Z\xED\xA0\x80");
+		EXPECT_EQ(c.utf8(), "A\xEF\xBF\xBDZ\xEF\xBF\xBD");
+	}
+}
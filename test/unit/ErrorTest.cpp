@@ -6,6 +6,8 @@
 #include "Error.h"
 
 #include "gtest/gtest.h"
+#include <string>
+#include <utility>
 
 using namespace ZXing;
 
@@ -41,3 +43,56 @@ TEST(ErrorTest, WithMsg)
 	EXPECT_EQ(e.msg(), "something is wrong");
 	EXPECT_EQ(e.location(), "ErrorTest.cpp:" + std::to_string(line));
 }
+
+TEST(ErrorTest, DynamicMsg)
+{
+	std::string msg = "something";
+	Error e(Error::Format, msg + " is wrong");
+	msg.clear();
+
+	EXPECT_EQ(e.msg(), "something is wrong");
+	EXPECT_TRUE(e.location().empty());
+
+	// copies own a copy of the message
+	Error c = e;
+	EXPECT_EQ(c, e);
+	EXPECT_NE(c.msg().data(), e.msg().data());
+	e = FormatError("literal");
+	EXPECT_EQ(c.msg(), "something is wrong");
+	EXPECT_EQ(e.msg(), "literal");
+
+	// the moved-from object does not reference the message owned by m
+	Error m = std::move(c);
+	EXPECT_EQ(m.msg(), "something is wrong");
+	EXPECT_TRUE(c.msg().empty());
+	m = Error();
+	EXPECT_TRUE(c.msg().empty());
+	EXPECT_NE(c, e);
+}
+
+TEST(ErrorTest, ArrayMsg)
+{
+	// a char array is not a string literal, it has to be copied
+	Error e;
+	{
+		char buffer[32] = "buffer";
+		e = Error(Error::Format, buffer);
+		Error l(__FILE__, __LINE__, Error::Format, buffer);
+		EXPECT_NE(e.msg().data(), buffer);
+		EXPECT_NE(l.msg().data(), buffer);
+		buffer[0] = 'X';
+	}
+	EXPECT_EQ(e.msg(), "buffer");
+}
+
+TEST(ErrorTest, ToString)
+{
+	// copying an Error with a literal message does not allocate, the message is only assembled here
+	Error e = UnsupportedError("not yet"); int line = __LINE__;
+	Error c = e;
+
+	EXPECT_EQ(c, e);
+	EXPECT_EQ(c.msg().data(), e.msg().data());
+	EXPECT_EQ(ToString(c), "Unsupported (not yet) @ ErrorTest.cpp:" + std::to_string(line));
+	EXPECT_EQ(ToString(Error()), "");
+}
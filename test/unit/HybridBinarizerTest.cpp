@@ -0,0 +1,71 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "HybridBinarizer.h"
+
+#include "BitMatrix.h"
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+using namespace ZXing;
+
+TEST(HybridBinarizerTest, ContrastMap)
+{
+	constexpr int W = 203, H = 157; // not a multiple of the block size
+
+	// a light, slightly noisy background with a dark square and a bar pattern
+	PseudoRandom rand(7);
+	std::vector<uint8_t> img(W * H);
+	for (int y = 0; y < H; ++y)
+		for (int x = 0; x < W; ++x) {
+			int v = 200 + rand.next(0, 10);
+			if (x >= 150 && x < 180 && y >= 100 && y < 130)
+				v = 30;
+			if (y >= 40 && y < 60 && x >= 50 && x < 130 && x / 4 % 2)
+				v = 20;
+			img[y * W + x] = v;
+		}
+
+	HybridBinarizer binarizer({img.data(), W, H, ImageFormat::Lum});
+	EXPECT_EQ(binarizer.contrastMap(), nullptr);
+	auto bits = binarizer.getBitMatrix();
+	auto contrast = binarizer.contrastMap();
+	ASSERT_NE(contrast, nullptr);
+	ASSERT_EQ(Size(contrast->flatRows), H);
+	ASSERT_EQ(Size(contrast->flatCols), W);
+
+	auto isUniform = [](auto&& line) { return std::adjacent_find(line.begin(), line.end(), std::not_equal_to<>()) == line.end(); };
+	for (int y = 0; y < H; ++y)
+		if (contrast->flatRows[y]) {
+			EXPECT_TRUE(isUniform(bits->row(y))) << y;
+		}
+	for (int x = 0; x < W; ++x)
+		if (contrast->flatCols[x]) {
+			EXPECT_TRUE(isUniform(bits->col(x))) << x;
+		}
+
+	EXPECT_TRUE(contrast->flatRows[10]);
+	EXPECT_FALSE(contrast->flatRows[50]);
+	EXPECT_FALSE(contrast->flatRows[110]);
+	EXPECT_TRUE(contrast->flatRows[H - 1]);
+	EXPECT_TRUE(contrast->flatCols[20]);
+	EXPECT_FALSE(contrast->flatCols[100]);
+	EXPECT_FALSE(contrast->flatCols[160]);
+
+	EXPECT_LE(contrast->rowRanges[10], 16);
+	EXPECT_GE(contrast->rowRanges[50], 180);
+	EXPECT_GE(contrast->colRanges[160], 170);
+
+	PatternRow row;
+	EXPECT_FALSE(binarizer.getPatternRow(10, 0, row));
+	EXPECT_FALSE(binarizer.getPatternRow(W - 20, 270, row)); // column 19
+	EXPECT_TRUE(binarizer.getPatternRow(50, 0, row));
+
+	binarizer.close();
+	EXPECT_EQ(binarizer.contrastMap(), nullptr);
+}
@@ -0,0 +1,94 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PerspectiveTransform.h"
+
+#include "BitMatrix.h"
+#include "GridSampler.h"
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+// a 40 x 40 module grid seen at an angle
+static const PerspectiveTransform Skewed(Rectangle(0, 40, 0, 40, 0), {PointF{10, 12}, {300, 40}, {280, 310}, {20, 290}});
+
+TEST(PerspectiveTransformTest, ProjectRow)
+{
+	PointF::value_t xs[41], ys[41];
+	for (int y = 0; y <= 40; y += 5) {
+		auto p = centered(PointI{0, y});
+		Skewed.projectRow(p, 41, xs, ys);
+		for (int i = 0; i < 41; ++i) {
+			auto q = Skewed(p + PointF(i, 0));
+			EXPECT_NEAR(xs[i], q.x, 1e-3) << "x: " << i << ", y: " << y;
+			EXPECT_NEAR(ys[i], q.y, 1e-3) << "x: " << i << ", y: " << y;
+		}
+	}
+}
+
+TEST(PerspectiveTransformTest, IsPerspectiveIn)
+{
+	EXPECT_TRUE(Skewed.isPerspectiveIn(Rectangle(0, 40, 0, 40, 0)));
+	EXPECT_FALSE(PerspectiveTransform().isPerspectiveIn(Rectangle(0, 40, 0, 40, 0)));
+
+	// with the strongly converging sides of this trapezoid, module row -1.5 is projected to infinity (the denominator is
+	// 0 there) and the module rows above it end up below the trapezoid
+	PerspectiveTransform vanishing(Rectangle(0, 1, 0, 1, 0), {PointF{0, 0}, {100, 0}, {80, 50}, {20, 50}});
+	EXPECT_TRUE(vanishing.isPerspectiveIn(Rectangle(0, 1, -1, 10, 0)));
+	EXPECT_FALSE(vanishing.isPerspectiveIn(Rectangle(0, 1, -2, 1, 0)));
+	EXPECT_FALSE(vanishing.isPerspectiveIn(Rectangle(0, 1, -10, 10, 0)));
+}
+
+TEST(PerspectiveTransformTest, SampleGrid)
+{
+	PseudoRandom rand(7);
+	BitMatrix image(400, 400);
+	for (int y = 0; y < image.height(); ++y)
+		for (int x = 0; x < image.width(); ++x)
+			image.set(x, y, rand.next(0, 1));
+
+	auto reference = [&](const PerspectiveTransform& mod2Pix) {
+		BitMatrix res(40, 40);
+		for (int y = 0; y < 40; ++y)
+			for (int x = 0; x < 40; ++x)
+				res.set(x, y, image.get(mod2Pix(centered(PointI{x, y}))));
+		return res;
+	};
+
+	// well inside the image, which uses the unchecked projectRow path
+	EXPECT_EQ(SampleGrid(image, 40, 40, Skewed).bits(), reference(Skewed));
+
+	// touching the image border, which uses the checked path
+	PerspectiveTransform border(Rectangle(0, 40, 0, 40, 0), {PointF{0, 0}, {399.9, 0}, {399.9, 399.9}, {0, 399.9}});
+	EXPECT_EQ(SampleGrid(image, 40, 40, border).bits(), reference(border));
+
+	// grid points outside the image
+	PerspectiveTransform outside(Rectangle(0, 40, 0, 40, 0), {PointF{-10, 0}, {300, 0}, {300, 300}, {-10, 300}});
+	EXPECT_FALSE(SampleGrid(image, 40, 40, outside).isValid());
+}
+
+TEST(PerspectiveTransformTest, SampleGridHorizonInLastHalfModule)
+{
+	// the vanishing trapezoid from above, set up so that its horizon is at row (or column) 39.25 of a 40 x 40 grid, i.e.
+	// between the outer edge of the last module row and the center of its modules, where it is sampled
+	PerspectiveTransform vanishing(Rectangle(0, 1, 0, 1, 0), {PointF{0, 0}, {100, 0}, {80, 50}, {20, 50}});
+	auto trapezoid = [&](PointF p) { return vanishing(PointF(p.x / 40, 1 - (p.y / 39.25) * 2.5)) + PointF(150, 150); };
+	QuadrilateralF src = {PointF{0, 0}, {40, 0}, {40, 20}, {0, 20}};
+	QuadrilateralF dst = {trapezoid(src[0]), trapezoid(src[1]), trapezoid(src[2]), trapezoid(src[3])};
+	PerspectiveTransform rows(src, dst);
+	// the same with transposed grid coordinates
+	PerspectiveTransform cols({PointF{0, 0}, {0, 40}, {20, 40}, {20, 0}}, dst);
+
+	for (auto& mod2Pix : {rows, cols}) {
+		// the edge of the grid is still on the good side of the horizon, the sample points of the last modules are not
+		EXPECT_TRUE(mod2Pix.isPerspectiveIn(Rectangle(0, 39, 0, 39, 0)));
+		EXPECT_FALSE(mod2Pix.isPerspectiveIn(Rectangle(0, 39, 0, 39)));
+
+		BitMatrix image(400, 400);
+		EXPECT_FALSE(SampleGrid(image, 40, 40, mod2Pix).isValid());
+	}
+}
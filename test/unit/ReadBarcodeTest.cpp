@@ -0,0 +1,56 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReadBarcode.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing;
+
+// a width x height image filled with bg, with vertical bars of the given module width and color in the middle
+static std::vector<uint8_t> Bars(int width, int height, uint8_t bg, uint8_t fg, int moduleWidth, int count)
+{
+	std::vector<uint8_t> img(width * height, bg);
+	int x0 = (width - 2 * count * moduleWidth) / 2;
+	for (int y = 0; y < height; ++y)
+		for (int i = 0; i < count; ++i)
+			for (int x = 0; x < moduleWidth; ++x)
+				img[y * width + x0 + 2 * i * moduleWidth + x] = fg;
+	return img;
+}
+
+TEST(ReadBarcodeTest, HasPotentialBarcode)
+{
+	auto blank = Bars(640, 480, 200, 200, 1, 0);
+	EXPECT_FALSE(HasPotentialBarcode({blank.data(), 640, 480, ImageFormat::Lum}));
+
+	auto lowContrast = Bars(640, 480, 130, 115, 3, 20);
+	EXPECT_FALSE(HasPotentialBarcode({lowContrast.data(), 640, 480, ImageFormat::Lum}));
+
+	auto bars = Bars(640, 480, 230, 20, 3, 20);
+	EXPECT_TRUE(HasPotentialBarcode({bars.data(), 640, 480, ImageFormat::Lum}));
+	EXPECT_TRUE(HasPotentialBarcode(ImageView(bars.data(), 640, 480, ImageFormat::Lum).rotated(90)));
+
+	// a single line scan
+	auto line = Bars(200, 1, 255, 0, 2, 10);
+	EXPECT_TRUE(HasPotentialBarcode({line.data(), 200, 1, ImageFormat::Lum}));
+
+	// red bars on black background, the luminance contrast is sufficient
+	std::vector<uint8_t> rgb(3 * 300 * 100);
+	for (int i = 0; i < 300 * 100; ++i)
+		rgb[3 * i] = i % 300 / 10 % 2 ? 255 : 0;
+	ImageView rgbView(rgb.data(), 300, 100, ImageFormat::RGB);
+	EXPECT_TRUE(HasPotentialBarcode(rgbView));
+	// a single edge is not enough
+	EXPECT_FALSE(HasPotentialBarcode(rgbView.cropped(5, 0, 8, 100)));
+}
+
+TEST(ReadBarcodeTest, SkipBlankImages)
+{
+	auto blank = Bars(640, 480, 128, 128, 1, 0);
+	auto opts = ReaderOptions().setSkipBlankImages(true).setReturnErrors(true);
+	EXPECT_TRUE(ReadBarcodes({blank.data(), 640, 480, ImageFormat::Lum}, opts).empty());
+}
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <ostream>
+#include <tuple>
 
 static std::ostream& operator<<(std::ostream& out, const ZXing::GenericGF& field) {
 	out << "GF(" << field.size() << ',' << field.generatorBase() << ')';
@@ -39,6 +40,16 @@ namespace {
 		message.resize(message.size() + ecWords.size());
 		ReedSolomonEncode(field, message, Size(ecWords));
 		EXPECT_EQ(message, messageExpected) << "Encode in " << field << " (" << dataWords.size() << ',' << ecWords.size() << ") failed";
+
+		if (field.size() <= 256) {
+			// interleave the byte code words with a (zero) second block to test the stride parameter
+			std::vector<uint8_t> bytes(2 * message.size());
+			for (size_t i = 0; i < dataWords.size(); ++i)
+				bytes[2 * i] = static_cast<uint8_t>(dataWords[i]);
+			ReedSolomonEncode(field, bytes.data(), Size(dataWords), bytes.data() + 2 * dataWords.size(), Size(ecWords), 2);
+			for (size_t i = 0; i < ecWords.size(); ++i)
+				EXPECT_EQ(bytes[2 * (dataWords.size() + i)], ecWords[i]) << "Byte encode in " << field << " failed at " << i;
+		}
 	}
 
 	void Corrupt(std::vector<int>& received, size_t howMany, PseudoRandom& random, int max) {
@@ -494,3 +505,60 @@ TEST(ReedSolomonTest, Aztec)
 	TestEncodeDecodeRandom(GenericGF::AztecData10(), 768, 255);
 	TestEncodeDecodeRandom(GenericGF::AztecData12(), 3072, 1023);
 }
+
+TEST(ReedSolomonTest, FieldTables)
+{
+	for (auto* field : {&GenericGF::AztecData12(), &GenericGF::AztecData10(), &GenericGF::AztecData6(), &GenericGF::AztecParam(),
+						&GenericGF::QRCodeField256(), &GenericGF::DataMatrixField256(), &GenericGF::AztecData8(),
+						&GenericGF::MaxiCodeField64()}) {
+		for (int a = 1; a < field->size(); ++a) {
+			ASSERT_EQ(field->exp(field->log(a)), a) << *field;
+			ASSERT_EQ(field->multiply(a, field->inverse(a)), 1) << *field;
+		}
+		// multiplication distributes over addition (xor), which only holds for the tables of the actual field
+		PseudoRandom random(field->size());
+		for (int i = 0; i < 1000; ++i) {
+			int a = random.next(0, field->size() - 1), b = random.next(0, field->size() - 1), c = random.next(0, field->size() - 1);
+			ASSERT_EQ(field->multiply(a, b ^ c), field->multiply(a, b) ^ field->multiply(a, c)) << *field;
+		}
+	}
+}
+
+TEST(ReedSolomonTest, DecoderLimits)
+{
+	PseudoRandom random(42);
+	// the Aztec case has more than 256 EC codewords, which exceeds the fixed size scratch buffer of the decoder
+	for (auto [field, dataSize, ecSize] : {std::tuple{&GenericGF::QRCodeField256(), 100, 30}, {&GenericGF::AztecData12(), 200, 600}}) {
+		std::vector<int> codeword(dataSize + ecSize);
+		for (int i = 0; i < dataSize; ++i)
+			codeword[i] = random.next(0, field->size() - 1);
+		ReedSolomonEncode(*field, codeword, ecSize);
+
+		// no errors
+		auto message = codeword;
+		EXPECT_TRUE(ReedSolomonDecode(*field, message, ecSize));
+		EXPECT_EQ(message, codeword);
+
+		// the maximal number of errors
+		Corrupt(message, ecSize / 2, random, field->size());
+		EXPECT_TRUE(ReedSolomonDecode(*field, message, ecSize)) << *field;
+		EXPECT_EQ(message, codeword) << *field;
+
+		// one error too many is either detected or 'corrected' into a different valid codeword
+		for (int i = 0; i < 10; ++i) {
+			message = codeword;
+			Corrupt(message, ecSize / 2 + 1, random, field->size());
+			if (ReedSolomonDecode(*field, message, ecSize)) {
+				EXPECT_NE(message, codeword) << *field;
+				auto reencoded = message;
+				ReedSolomonEncode(*field, reencoded, ecSize);
+				EXPECT_EQ(message, reencoded) << *field;
+			}
+		}
+
+		// codewords outside of the field are rejected
+		message = codeword;
+		message[dataSize / 2] = field->size();
+		EXPECT_FALSE(ReedSolomonDecode(*field, message, ecSize)) << *field;
+	}
+}
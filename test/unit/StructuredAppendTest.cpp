@@ -0,0 +1,68 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Barcode.h"
+#include "DecoderResult.h"
+#include "DetectorResult.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+static Barcode Part(const std::string& text, int index, int count, const std::string& id = "42",
+					BarcodeFormat format = BarcodeFormat::QRCode)
+{
+	return Barcode(DecoderResult(Content(ByteArray(text), {'Q', '1'})).setStructuredAppend({index, count, id}),
+				   DetectorResult({}, {}), format);
+}
+
+TEST(StructuredAppendTest, Assembler)
+{
+	StructuredAppendAssembler assembler;
+
+	EXPECT_FALSE(assembler.add(Part("B", 1, 3)).isValid());
+	EXPECT_FALSE(assembler.add(Part("x", 0, 2, "7")).isValid());
+	EXPECT_FALSE(assembler.add(Part("C", 2, 3)).isValid());
+	EXPECT_FALSE(assembler.add(Part("C", 2, 3)).isValid()); // duplicate
+	EXPECT_FALSE(assembler.add(Part("D", 3, 3)).isValid()); // index out of range
+	EXPECT_FALSE(assembler.add(Part("A", 0, 4)).isValid()); // different count
+	EXPECT_FALSE(assembler.add(Part("A", 0, 3, "42", BarcodeFormat::DataMatrix)).isValid());
+	EXPECT_EQ(assembler.pendingCount(), 3);
+
+	auto merged = assembler.add(Part("A", 0, 3));
+	EXPECT_TRUE(merged.isValid());
+	EXPECT_EQ(merged.text(), "ABC");
+	EXPECT_EQ(merged.sequenceIndex(), -1);
+	EXPECT_EQ(merged.sequenceSize(), 3);
+	EXPECT_EQ(merged.sequenceId(), "42");
+	EXPECT_EQ(merged.symbologyIdentifier(), "]Q1");
+	EXPECT_EQ(assembler.pendingCount(), 2);
+
+	EXPECT_EQ(assembler.add(Part("y", 1, 2, "7")).text(), "xy");
+	EXPECT_EQ(assembler.pendingCount(), 1);
+}
+
+TEST(StructuredAppendTest, UnknownCount)
+{
+	// PDF417 symbols may only tell the count in the last one
+	StructuredAppendAssembler assembler;
+	EXPECT_FALSE(assembler.add(Part("C", 2, 3, "1", BarcodeFormat::PDF417)).isValid());
+	EXPECT_FALSE(assembler.add(Part("A", 0, 0, "1", BarcodeFormat::PDF417)).isValid());
+	EXPECT_EQ(assembler.add(Part("B", 1, 0, "1", BarcodeFormat::PDF417)).text(), "ABC");
+	EXPECT_EQ(assembler.pendingCount(), 0);
+}
+
+TEST(StructuredAppendTest, MergeSequences)
+{
+	Barcodes barcodes = {Part("2", 1, 2, "b"), Part("B", 1, 2), Part("B", 1, 2), Part("single", -1, -1), Part("A", 0, 2),
+						 Part("1", 0, 2, "b")};
+	auto merged = MergeStructuredAppendSequences(barcodes);
+	ASSERT_EQ(merged.size(), 2);
+	EXPECT_EQ(merged[0].text(), "AB");
+	EXPECT_EQ(merged[1].text(), "12");
+
+	EXPECT_EQ(MergeStructuredAppendSequence({barcodes[1], barcodes[4]}).text(), "AB");
+	EXPECT_TRUE(MergeStructuredAppendSequence({barcodes[1], barcodes[2], barcodes[4]}).error());
+}
@@ -3,6 +3,7 @@
 */
 // SPDX-License-Identifier: Apache-2.0
 
+#include "ByteArray.h"
 #include "CharacterSet.h"
 #include "TextDecoder.h"
 #include "Utf.h"
@@ -97,6 +98,26 @@ TEST(TextDecoderTest, AppendISO8859Range80_9F)
 	}
 }
 
+TEST(TextDecoderTest, AppendISO8859_1)
+{
+	uint8_t data[256];
+	std::iota(std::begin(data), std::end(data), 0);
+
+	std::wstring str = FromUtf8(BytesToUtf8(data, CharacterSet::ISO8859_1));
+	EXPECT_THAT(str, ElementsAreArray(data));
+	EXPECT_EQ(BytesToUtf8(ByteView(data).subview(0xC0, 8), ECI::Unknown), "\u00C0\u00C1\u00C2\u00C3\u00C4\u00C5\u00C6\u00C7");
+}
+
+TEST(TextDecoderTest, GuessASCII)
+{
+	auto guess = [](std::string_view text, CharacterSet fallback = CharacterSet::ISO8859_1) {
+		return GuessTextEncoding(ByteArray(std::string(text)), fallback);
+	};
+	EXPECT_EQ(guess("Hello\r\nWorld"), CharacterSet::ISO8859_1);
+	EXPECT_EQ(guess("Hello\r\nWorld", CharacterSet::Shift_JIS), CharacterSet::Shift_JIS);
+	EXPECT_EQ(guess("Tab\tTab", CharacterSet::Shift_JIS), CharacterSet::ISO8859_1);
+}
+
 TEST(TextDecoderTest, AppendShift_JIS)
 {
 	{
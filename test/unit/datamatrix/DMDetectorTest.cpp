@@ -0,0 +1,103 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "DecoderResult.h"
+#include "ReadBarcode.h"
+#include "datamatrix/DMDecoder.h"
+#include "datamatrix/DMDetector.h"
+#include "datamatrix/DMWriter.h"
+
+#include "gtest/gtest.h"
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+
+// four symbols in a 2 x 2 grid, the ones on the right are rotated by 90 degree
+static BitMatrix CreateImage()
+{
+	BitMatrix image(400, 400);
+	for (int i = 0; i < 4; ++i) {
+		auto bits = DataMatrix::Writer().setMargin(0).encode(L"DM " + std::to_wstring(i), 120, 120);
+		int left = 40 + (i % 2) * 200, top = 40 + (i / 2) * 200;
+		for (int y = 0; y < bits.height(); ++y)
+			for (int x = 0; x < bits.width(); ++x)
+				if (i % 2 ? bits.get(bits.width() - 1 - y, x) : bits.get(x, y))
+					image.set(left + x, top + y);
+	}
+	return image;
+}
+
+static std::vector<DetectorResult> DetectAll(const BitMatrix& image, bool parallel)
+{
+	std::vector<DetectorResult> res;
+	for (auto&& detRes : DataMatrix::Detect(image, true, true, false, parallel))
+		res.push_back(std::move(detRes));
+	return res;
+}
+
+TEST(DMDetectorTest, MultipleSymbols)
+{
+	auto image = CreateImage();
+
+	auto serial = DetectAll(image, false);
+	auto parallel = DetectAll(image, true);
+
+	// the parallel scan computes the same results in the same order
+	ASSERT_EQ(serial.size(), parallel.size());
+	std::set<std::wstring> texts;
+	for (size_t i = 0; i < serial.size(); ++i) {
+		EXPECT_EQ(serial[i].bits(), parallel[i].bits()) << "result " << i;
+		EXPECT_EQ(serial[i].position(), parallel[i].position()) << "result " << i;
+		auto decRes = DataMatrix::Decode(serial[i].bits());
+		if (decRes.isValid())
+			texts.insert(decRes.text());
+	}
+	EXPECT_EQ(texts, (std::set<std::wstring>{L"DM 0", L"DM 1", L"DM 2", L"DM 3"}));
+}
+
+TEST(DMDetectorTest, ReadBarcodes)
+{
+	auto image = CreateImage();
+	auto buf = std::vector<uint8_t>(image.width() * image.height());
+	for (int y = 0; y < image.height(); ++y)
+		for (int x = 0; x < image.width(); ++x)
+			buf[y * image.width() + x] = image.get(x, y) ? 0 : 0xFF;
+
+	for (int maxThreads : {0, 1}) {
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::DataMatrix).setMaxThreads(maxThreads);
+		auto barcodes = ReadBarcodes(ImageView(buf.data(), image.width(), image.height(), ImageFormat::Lum), opts);
+		std::set<std::string> texts;
+		for (auto& barcode : barcodes)
+			texts.insert(barcode.text());
+		EXPECT_EQ(Size(barcodes), 4) << "maxThreads: " << maxThreads;
+		EXPECT_EQ(texts, (std::set<std::string>{"DM 0", "DM 1", "DM 2", "DM 3"})) << "maxThreads: " << maxThreads;
+	}
+}
+
+TEST(DMDetectorTest, ManySymbols)
+{
+	// more than the former limit of 255 symbols per call
+	constexpr int N = 20, PITCH = 60;
+	std::vector<uint8_t> buf(N * PITCH * N * PITCH, 0xFF);
+	for (int i = 0; i < N * N; ++i) {
+		auto bits = DataMatrix::Writer().setMargin(0).encode(std::to_wstring(1000 + i), 40, 40);
+		int left = 10 + (i % N) * PITCH, top = 10 + (i / N) * PITCH;
+		for (int y = 0; y < bits.height(); ++y)
+			for (int x = 0; x < bits.width(); ++x)
+				if (bits.get(x, y))
+					buf[(top + y) * N * PITCH + left + x] = 0;
+	}
+
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::DataMatrix).setMaxNumberOfSymbols(0);
+	auto barcodes = ReadBarcodes(ImageView(buf.data(), N * PITCH, N * PITCH, ImageFormat::Lum), opts);
+	std::set<std::string> texts;
+	for (auto& barcode : barcodes)
+		texts.insert(barcode.text());
+	EXPECT_EQ(Size(barcodes), N * N);
+	EXPECT_EQ(Size(texts), N * N);
+}
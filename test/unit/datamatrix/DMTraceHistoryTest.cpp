@@ -0,0 +1,110 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "datamatrix/DMTraceHistory.h"
+
+#include "PseudoRandom.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::DataMatrix;
+
+TEST(DMTraceHistoryTest, GetSet)
+{
+	// image size not a multiple of the tile size
+	const int width = 100, height = 70;
+	TraceHistory history(width, height);
+	std::vector<int> reference(width * height, 0);
+
+	EXPECT_EQ(history.usedTiles(), 0);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			EXPECT_EQ(history.get({x, y}), 0);
+
+	PseudoRandom random(38);
+	for (int i = 0; i < 5000; ++i) {
+		PointI p = {random.next(0, width - 1), random.next(0, height - 1)};
+		int state = random.next(0, 3);
+		history.set(p, state);
+		reference[p.y * width + p.x] = state;
+	}
+
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			ASSERT_EQ(history.get({x, y}), reference[y * width + x]) << x << "," << y;
+
+	// the neighbors are left untouched, including the ones in the adjacent 64 bit row
+	history.set({31, 40}, 3);
+	history.set({32, 40}, 0);
+	EXPECT_EQ(history.get({31, 40}), 3);
+	EXPECT_EQ(history.get({32, 40}), 0);
+	history.set({31, 40}, 1);
+	EXPECT_EQ(history.get({31, 40}), 1);
+
+	// the corners, the right and bottom tiles are only partially inside the image
+	history.set({0, 0}, 1);
+	history.set({width - 1, 0}, 2);
+	history.set({0, height - 1}, 3);
+	history.set({width - 1, height - 1}, 1);
+	EXPECT_EQ(history.get({0, 0}), 1);
+	EXPECT_EQ(history.get({width - 1, 0}), 2);
+	EXPECT_EQ(history.get({0, height - 1}), 3);
+	EXPECT_EQ(history.get({width - 1, height - 1}), 1);
+}
+
+TEST(DMTraceHistoryTest, SparseTiles)
+{
+	TraceHistory history(1000, 1000);
+
+	// a trace along a single line only touches the tiles it crosses
+	for (int x = 100; x < 300; ++x)
+		history.set({x, 500}, 1);
+	EXPECT_EQ(history.usedTiles(), 7); // x = 96..319
+	EXPECT_EQ(history.get({99, 500}), 0);
+	EXPECT_EQ(history.get({299, 500}), 1);
+	EXPECT_EQ(history.get({300, 500}), 0);
+	EXPECT_EQ(history.get({150, 499}), 0);
+
+	// writing to the same tiles again does not allocate new ones, also not a 0 state
+	for (int x = 100; x < 300; ++x)
+		history.set({x, 510}, 0);
+	EXPECT_EQ(history.usedTiles(), 7);
+
+	history.clear();
+	EXPECT_EQ(history.usedTiles(), 0);
+	for (int x = 90; x < 330; ++x)
+		EXPECT_EQ(history.get({x, 500}), 0);
+}
+
+TEST(DMTraceHistoryTest, ReuseAfterClear)
+{
+	const int width = 200, height = 200;
+	TraceHistory history(width, height);
+
+	// the tile memory is recycled by the next direction, make sure no stale state leaks into other tiles
+	PseudoRandom random(2025);
+	for (int round = 0; round < 20; ++round) {
+		std::vector<int> reference(width * height, 0);
+		// one horizontal and one vertical trace
+		int row = random.next(0, height - 1), left = random.next(0, 50), right = random.next(100, width - 1);
+		for (int x = left; x <= right; ++x) {
+			history.set({x, row}, round % 3 + 1);
+			reference[row * width + x] = round % 3 + 1;
+		}
+		int col = random.next(0, width - 1), top = random.next(0, 50), bottom = random.next(100, height - 1);
+		for (int y = top; y <= bottom; ++y) {
+			history.set({col, y}, round % 2 + 2);
+			reference[y * width + col] = round % 2 + 2;
+		}
+
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				ASSERT_EQ(history.get({x, y}), reference[y * width + x]) << round << ": " << x << "," << y;
+
+		history.clear();
+	}
+}
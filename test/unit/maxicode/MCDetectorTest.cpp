@@ -0,0 +1,124 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "maxicode/MCDetector.h"
+
+#include "BitMatrix.h"
+#include "DetectorResult.h"
+#include "maxicode/MCBitMatrixParser.h"
+
+#include "gtest/gtest.h"
+#include <cmath>
+#include <random>
+
+using namespace ZXing;
+using namespace ZXing::MaxiCode;
+
+constexpr int WIDTH = BitMatrixParser::MATRIX_WIDTH;
+constexpr int HEIGHT = BitMatrixParser::MATRIX_HEIGHT;
+
+// module center relative to the bullseye, which is centered on module (14, 16)
+static PointF ModuleCenter(int col, int row)
+{
+	return {col - 14 + 0.5 * (row & 1), (row - 16) * std::sqrt(3) / 2};
+}
+
+static bool IsInBullseyeArea(int col, int row)
+{
+	return length(ModuleCenter(col, row)) < 5.6;
+}
+
+// random modules with the orientation pattern around the bullseye set
+static BitMatrix CreateModules(unsigned seed)
+{
+	std::mt19937 gen(seed);
+	BitMatrix bits(WIDTH, HEIGHT);
+	for (int row = 0; row < HEIGHT; ++row)
+		for (int col = 0; col < WIDTH - (row & 1); ++col)
+			if (!IsInBullseyeArea(col, row) && gen() % 2)
+				bits.set(col, row);
+
+	for (auto [col, row, dark] : {std::tuple{10, 9, true}, {11, 9, true}, {11, 10, true}, {17, 9, false}, {17, 10, false},
+								  {18, 10, false}, {7, 15, true}, {7, 16, false}, {8, 16, true}, {20, 16, true}, {21, 16, false},
+								  {20, 17, true}, {10, 22, true}, {11, 22, false}, {10, 23, true}, {17, 22, true},
+								  {16, 23, false}, {17, 23, true}})
+		bits.set(col, row, dark);
+
+	return bits;
+}
+
+// Draw the modules as round dots and the bullseye into a size x size image. The symbol is rotated by angle (in degrees),
+// sheared horizontally and scaled such that the module distance is scale pixels.
+static BitMatrix Render(const BitMatrix& bits, int size, double scale, double angle, double shear)
+{
+	double a = angle * 3.14159265358979323846 / 180, c = std::cos(a), s = std::sin(a);
+	BitMatrix image(size, size);
+	for (int y = 0; y < size; ++y)
+		for (int x = 0; x < size; ++x) {
+			// map the pixel back into the module plane: inverse rotation, then inverse shear
+			double px = (x + 0.5 - size / 2.) / scale, py = (y + 0.5 - size / 2.) / scale;
+			double u = c * px + s * py, v = -s * px + c * py;
+			u -= shear * v;
+
+			double r = std::sqrt(u * u + v * v);
+			if (r < 4.56) {
+				// the light center and the 3 dark rings, each 0.8 modules wide
+				image.set(x, y, r > 0.56 && int((r - 0.56) / 0.8) % 2 == 0);
+				continue;
+			}
+
+			int row0 = int(std::floor(v / (std::sqrt(3) / 2))) + 16;
+			for (int row = row0; row <= row0 + 1; ++row) {
+				int col = int(std::lround(u + 14 - 0.5 * (row & 1)));
+				if (row < 0 || row >= HEIGHT || col < 0 || col >= WIDTH)
+					continue;
+				if (bits.get(col, row) && distance(ModuleCenter(col, row), PointF(u, v)) < 0.45)
+					image.set(x, y);
+			}
+		}
+	return image;
+}
+
+static void CheckDetect(const BitMatrix& bits, const BitMatrix& image)
+{
+	auto bullseyes = ScanRowsForConcentricPatterns(image, {BullseyeRowScan(image, false)}).front();
+	ASSERT_EQ(bullseyes.size(), 1);
+
+	auto detRes = Detect(image, bullseyes.front());
+	ASSERT_TRUE(detRes.isValid());
+	for (int row = 0; row < HEIGHT; ++row)
+		for (int col = 0; col < WIDTH - (row & 1); ++col)
+			if (!IsInBullseyeArea(col, row)) {
+				EXPECT_EQ(detRes.bits().get(col, row), bits.get(col, row)) << col << "x" << row;
+			}
+}
+
+TEST(MCDetectorTest, Rotated)
+{
+	auto bits = CreateModules(42);
+	for (double angle : {0, 30, 90, 135, 200, 333})
+		CheckDetect(bits, Render(bits, 500, 10, angle, 0));
+}
+
+TEST(MCDetectorTest, Skewed)
+{
+	auto bits = CreateModules(7);
+	for (double shear : {-0.2, 0.15})
+		CheckDetect(bits, Render(bits, 500, 9, 20, shear));
+}
+
+TEST(MCDetectorTest, NoOrientationPattern)
+{
+	auto bits = CreateModules(42);
+	for (int row = 9; row <= 23; ++row)
+		for (int col = 7; col <= 21; ++col)
+			if (!IsInBullseyeArea(col, row))
+				bits.set(col, row, false);
+
+	auto image = Render(bits, 500, 10, 0, 0);
+	auto bullseyes = ScanRowsForConcentricPatterns(image, {BullseyeRowScan(image, false)}).front();
+	ASSERT_EQ(bullseyes.size(), 1);
+	EXPECT_FALSE(Detect(image, bullseyes.front()).isValid());
+}
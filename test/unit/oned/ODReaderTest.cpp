@@ -0,0 +1,57 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "ReadBarcode.h"
+#include "oned/ODCode128Writer.h"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::OneD;
+
+// Render cols x rows short Code 128 symbols with a bar height of barHeight pixels, separated by gap pixels.
+static std::vector<uint8_t> RenderSheet(int cols, int rows, int barHeight, int gap, int& width, int& height)
+{
+	std::vector<BitMatrix> symbols;
+	int symbolWidth = 0;
+	for (int i = 0; i < cols * rows; ++i) {
+		symbols.push_back(Code128Writer().setMargin(10).encode("S" + std::to_string(1000 + i), 0, 1));
+		symbolWidth = std::max(symbolWidth, symbols.back().width() * 2);
+	}
+
+	width = cols * (symbolWidth + 20);
+	height = rows * (barHeight + gap) + gap;
+	std::vector<uint8_t> img(width * height, 255);
+	for (int i = 0; i < cols * rows; ++i) {
+		int x0 = (i % cols) * (symbolWidth + 20) + 10, y0 = gap + (i / cols) * (barHeight + gap);
+		for (int y = y0; y < y0 + barHeight; ++y)
+			for (int x = 0; x < symbols[i].width() * 2; ++x)
+				img[y * width + x0 + x] = symbols[i].get(x / 2, 0) ? 0 : 255;
+	}
+	return img;
+}
+
+TEST(ODReaderTest, StackedSymbolSheet)
+{
+	// the symbols are only about 1/300 of the image height, so a coarse row step would skip some of them
+	for (int barHeight : {10, 12}) {
+		int width, height;
+		auto img = RenderSheet(2, 150, barHeight, 26 - barHeight, width, height);
+		auto opts = ReaderOptions().setFormats(BarcodeFormat::Code128).setTryHarder(true).setTryRotate(false).setMaxNumberOfSymbols(0);
+		auto res = ReadBarcodes({img.data(), width, height, ImageFormat::Lum}, opts);
+
+		std::vector<std::string> texts;
+		for (const auto& r : res)
+			texts.push_back(r.text());
+		std::sort(texts.begin(), texts.end());
+		texts.erase(std::unique(texts.begin(), texts.end()), texts.end());
+		EXPECT_EQ(Size(res), 300) << barHeight;
+		EXPECT_EQ(Size(texts), 300) << barHeight;
+	}
+}
@@ -0,0 +1,66 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pdf417/PDFBarcodeValue.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing::Pdf417;
+
+using Values = std::vector<int>;
+
+TEST(PDF417BarcodeValueTest, Votes)
+{
+	BarcodeValues values(3);
+	EXPECT_EQ(values.value(0), Values{});
+
+	values.setValue(0, 7);
+	values.setValue(0, 5);
+	values.setValue(0, 7);
+	EXPECT_EQ(values.value(0), Values{7});
+	EXPECT_EQ(values.confidence(0, 7), 2);
+	EXPECT_EQ(values.confidence(0, 5), 1);
+	EXPECT_EQ(values.confidence(0, 6), 0);
+
+	// ties are returned in ascending order
+	values.setValue(0, 5);
+	EXPECT_EQ(values.value(0), (Values{5, 7}));
+
+	// the cells are independent of each other
+	EXPECT_EQ(values.value(1), Values{});
+	values.setValue(2, 5);
+	EXPECT_EQ(values.value(2), Values{5});
+	EXPECT_EQ(values.confidence(2, 5), 1);
+	EXPECT_EQ(values.confidence(0, 5), 2);
+}
+
+TEST(PDF417BarcodeValueTest, Overflow)
+{
+	// more distinct values than there are slots per cell
+	BarcodeValues values(2);
+	for (int v = 10; v > 0; --v)
+		values.setValue(1, v);
+	values.setValue(0, 3);
+	EXPECT_EQ(values.value(1), (Values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+	EXPECT_EQ(values.value(0), Values{3});
+
+	// the most frequent value may be one of the overflowed ones
+	values.setValue(1, 2);
+	values.setValue(1, 2);
+	values.setValue(1, 9);
+	EXPECT_EQ(values.value(1), Values{2});
+	EXPECT_EQ(values.confidence(1, 2), 3);
+	EXPECT_EQ(values.confidence(1, 9), 2);
+	EXPECT_EQ(values.confidence(0, 2), 0);
+
+	// init() clears all votes, including the overflowed ones
+	values.init(2);
+	EXPECT_EQ(values.value(1), Values{});
+	EXPECT_EQ(values.confidence(1, 2), 0);
+	std::vector<int> result = {42};
+	values.value(1, result);
+	EXPECT_TRUE(result.empty());
+}
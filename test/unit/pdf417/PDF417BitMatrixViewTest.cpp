@@ -0,0 +1,44 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BitMatrix.h"
+#include "pdf417/PDFBitMatrixView.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+using namespace ZXing::Pdf417;
+
+static void ExpectEqual(const BitMatrixView& view, const BitMatrix& expected)
+{
+	ASSERT_EQ(view.width(), expected.width());
+	ASSERT_EQ(view.height(), expected.height());
+	for (int y = 0; y < expected.height(); ++y)
+		for (int x = 0; x < expected.width(); ++x)
+			EXPECT_EQ(view.get(x, y), expected.get(x, y)) << "rotation " << view.rotation() << " at " << x << "," << y;
+}
+
+TEST(PDF417BitMatrixViewTest, Rotation)
+{
+	BitMatrix bits(7, 4);
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x)
+			bits.set(x, y, (x * 3 + y * 5) % 7 < 3);
+
+	ExpectEqual(BitMatrixView(bits, 0), bits);
+
+	BitMatrix rotated = bits.copy();
+	rotated.rotate180();
+	ExpectEqual(BitMatrixView(bits, 180), rotated);
+
+	rotated = bits.copy();
+	rotated.rotate90();
+	ExpectEqual(BitMatrixView(bits, 90), rotated);
+
+	rotated.rotate180();
+	ExpectEqual(BitMatrixView(bits, 270), rotated);
+
+	EXPECT_THROW(BitMatrixView(bits, 90).get(0, 7), std::out_of_range);
+}
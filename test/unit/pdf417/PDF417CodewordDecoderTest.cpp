@@ -0,0 +1,63 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pdf417/PDFCodewordDecoder.h"
+
+#include "gtest/gtest.h"
+#include <array>
+#include <vector>
+
+using namespace ZXing::Pdf417;
+
+static std::array<int, CodewordDecoder::BARS_IN_MODULE> BarWidths(int symbol)
+{
+	std::array<int, CodewordDecoder::BARS_IN_MODULE> res = {};
+	for (int i = CodewordDecoder::BARS_IN_MODULE - 1, bit = symbol & 1; i >= 0; --i, bit = !bit)
+		for (; (symbol & 1) == bit; symbol >>= 1)
+			res[i]++;
+	return res;
+}
+
+TEST(PDF417CodewordDecoderTest, GetCodeword)
+{
+	EXPECT_EQ(CodewordDecoder::GetCodeword(-1), -1);
+	EXPECT_EQ(CodewordDecoder::GetCodeword(0), -1);
+	EXPECT_EQ(CodewordDecoder::GetCodeword(0x20000 | 0x1a8c0), -1);
+
+	// every codeword is encoded exactly once in each of the 3 clusters
+	std::vector<int> counts(CodewordDecoder::NUMBER_OF_CODEWORDS);
+	int numSymbols = 0;
+	for (int symbol = 0x10000; symbol < 0x20000; ++symbol) {
+		int codeword = CodewordDecoder::GetCodeword(symbol);
+		if (codeword == -1)
+			continue;
+		ASSERT_GE(codeword, 0);
+		ASSERT_LT(codeword, CodewordDecoder::NUMBER_OF_CODEWORDS);
+		counts[codeword]++;
+		numSymbols++;
+	}
+	EXPECT_EQ(numSymbols, 2787);
+	for (int codeword = 0; codeword < CodewordDecoder::NUMBER_OF_CODEWORDS - 1; ++codeword)
+		EXPECT_EQ(counts[codeword], 3) << codeword;
+}
+
+TEST(PDF417CodewordDecoderTest, GetDecodedValue)
+{
+	for (int symbol = 0x10000; symbol < 0x20000; ++symbol) {
+		if (CodewordDecoder::GetCodeword(symbol) == -1)
+			continue;
+		auto widths = BarWidths(symbol);
+		ASSERT_EQ(CodewordDecoder::GetDecodedValue(widths), symbol);
+
+		// sampled with 3 pixels per module
+		for (auto& w : widths)
+			w *= 3;
+		ASSERT_EQ(CodewordDecoder::GetDecodedValue(widths), symbol);
+
+		// one pixel too many in the first bar needs the closest match fallback
+		widths[0] += 1;
+		ASSERT_EQ(CodewordDecoder::GetDecodedValue(widths), symbol);
+	}
+}
@@ -7,8 +7,11 @@
 #include "DecoderResult.h"
 #include "pdf417/PDFDecoder.h"
 #include "pdf417/PDFCustomData.h"
+#include "PseudoRandom.h"
 
 #include "gtest/gtest.h"
+#include <string>
+#include <vector>
 
 namespace ZXing::Pdf417 {
 int DecodeMacroBlock(const std::vector<int>& codewords, int codeIndex, PDF417CustomData& customData);
@@ -327,6 +330,57 @@ TEST(PDF417DecoderTest, NumericCompaction)
 		L"12345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
 }
 
+// The numeric compaction codewords of digits, computed by long division of the decimal number "1" + digits by 900
+static std::vector<int> NumericCodewords(const std::string& digits)
+{
+	std::vector<int> res;
+	for (size_t i = 0; i < digits.size(); i += 44) {
+		std::string number = "1" + digits.substr(i, 44);
+		std::vector<int> group;
+		while (number != "0") {
+			std::string quotient;
+			int remainder = 0;
+			for (char c : number) {
+				remainder = remainder * 10 + (c - '0');
+				if (!quotient.empty() || remainder >= 900)
+					quotient.push_back(static_cast<char>('0' + remainder / 900));
+				remainder %= 900;
+			}
+			group.insert(group.begin(), remainder);
+			number = quotient.empty() ? "0" : quotient;
+		}
+		res.insert(res.end(), group.begin(), group.end());
+	}
+	return res;
+}
+
+TEST(PDF417DecoderTest, NumericCompactionRandom)
+{
+	PseudoRandom random(900);
+	for (int i = 0; i < 500; ++i) {
+		int length = i < 100 ? i + 1 : random.next(1, 200);
+		std::string digits;
+		for (int j = 0; j < length; ++j)
+			digits.push_back(static_cast<char>('0' + random.next(0, 9)));
+		// leading zeros and the largest possible groups
+		if (i % 10 == 1)
+			std::fill(digits.begin(), digits.begin() + std::min(length, 20), '0');
+		if (i % 10 == 2)
+			std::fill(digits.begin(), digits.end(), '9');
+
+		std::vector<int> codewords = {0, 902};
+		auto numeric = NumericCodewords(digits);
+		codewords.insert(codewords.end(), numeric.begin(), numeric.end());
+		codewords[0] = static_cast<int>(codewords.size());
+		EXPECT_EQ(decode(codewords), std::wstring(digits.begin(), digits.end())) << digits;
+	}
+
+	// a group has to start with the leading 1
+	EXPECT_FALSE(valid({3, 902, 0}));
+	EXPECT_FALSE(valid({4, 902, 1, 0}));
+	EXPECT_EQ(decode({3, 902, 11}), L"1");
+}
+
 TEST(PDF417DecoderTest, CompactionCombos)
 {
 	// Text, Byte, Numeric, Text
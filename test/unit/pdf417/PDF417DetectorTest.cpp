@@ -0,0 +1,46 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pdf417/PDFDetector.h"
+
+#include "BitMatrix.h"
+#include "ThresholdBinarizer.h"
+#include "pdf417/PDFWriter.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::Pdf417;
+
+// the symbol is placed margin pixels away from the left and the top border of the image and rightMargin pixels away
+// from the right one
+static std::vector<int> DetectStopPatternEnds(const BitMatrix& bits, int margin, int rightMargin)
+{
+	int width = margin + bits.width() + rightMargin, height = bits.height() + 2 * margin;
+	std::vector<uint8_t> buf(width * height, 0xFF);
+	for (int y = 0; y < bits.height(); ++y)
+		for (int x = 0; x < bits.width(); ++x)
+			if (bits.get(x, y))
+				buf[(margin + y) * width + margin + x] = 0;
+
+	ThresholdBinarizer image(ImageView(buf.data(), width, height, ImageFormat::Lum));
+	auto res = Detector::Detect(image, false, false);
+	if (res.points.size() != 1 || res.points[0][2] == nullptr || res.points[0][3] == nullptr)
+		return {};
+	// vertices 2 and 3 are the top and bottom end of the stop pattern
+	return {static_cast<int>(res.points[0][2].value().x()), static_cast<int>(res.points[0][3].value().x())};
+}
+
+TEST(PDF417DetectorTest, StopPatternAtImageBorder)
+{
+	auto bits = Writer().setMargin(0).encode(L"PDF417 at the border", 0, 0);
+	ASSERT_FALSE(bits.empty());
+	int end = 10 + bits.width(); // the first white pixel right of the stop pattern
+
+	EXPECT_EQ(DetectStopPatternEnds(bits, 10, 10), (std::vector<int>{end, end}));
+	// without a white pixel after the stop pattern, it ends on the last pixel of the image
+	EXPECT_EQ(DetectStopPatternEnds(bits, 10, 0), (std::vector<int>{end - 1, end - 1}));
+}
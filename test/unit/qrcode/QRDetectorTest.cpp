@@ -0,0 +1,97 @@
+/*
+* Copyright 2025 ZXing authors
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "qrcode/QRDetector.h"
+
+#include "BitMatrix.h"
+#include "PseudoRandom.h"
+#include "ReadBarcode.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ZXing;
+using namespace ZXing::QRCode;
+
+// version 1 symbols with 3 pixel modules, separated by a 4 module quiet zone
+static constexpr int SYMBOL_SIZE = 21 * 3;
+static constexpr int PITCH = SYMBOL_SIZE + 4 * 3;
+
+static std::vector<uint8_t> CreateGrid(int n)
+{
+	int size = n * PITCH + 4 * 3;
+	std::vector<uint8_t> buf(size * size, 0xFF);
+	for (int i = 0; i < n * n; ++i) {
+		auto bits = Writer().setMargin(0).encode(L"QR " + std::to_wstring(i), SYMBOL_SIZE, SYMBOL_SIZE);
+		int left = 4 * 3 + (i % n) * PITCH, top = 4 * 3 + (i / n) * PITCH;
+		for (int y = 0; y < bits.height(); ++y)
+			for (int x = 0; x < bits.width(); ++x)
+				if (bits.get(x, y))
+					buf[(top + y) * size + left + x] = 0;
+	}
+	return buf;
+}
+
+TEST(QRDetectorTest, FinderPatternSetsOfDenseGrid)
+{
+	// 675 finder patterns, way more than the 64 nearest candidates considered per pattern
+	constexpr int N = 15;
+	int size = N * PITCH + 4 * 3;
+	auto buf = CreateGrid(N);
+	BitMatrix image(size, size);
+	for (int y = 0; y < size; ++y)
+		for (int x = 0; x < size; ++x)
+			if (buf[y * size + x] == 0)
+				image.set(x, y);
+
+	auto patterns = FindFinderPatterns(image, true);
+	ASSERT_GE(Size(patterns), 3 * N * N);
+
+	auto sets = GenerateFinderPatternSets(patterns);
+	auto isAt = [](PointF p, double x, double y) { return distance(p, PointF(x, y)) < 2; };
+	for (int i = 0; i < N * N; ++i) {
+		double left = 4 * 3 + (i % N) * PITCH + 10.5, top = 4 * 3 + (i / N) * PITCH + 10.5;
+		double right = left + SYMBOL_SIZE - 21, bottom = top + SYMBOL_SIZE - 21;
+		EXPECT_TRUE(FindIf(sets, [&](const FinderPatternSet& s) {
+						return isAt(s.tl, left, top) && isAt(s.tr, right, top) && isAt(s.bl, left, bottom);
+					}) != sets.end())
+			<< "symbol " << i;
+	}
+}
+
+TEST(QRDetectorTest, FinderPatternSetOfBigSymbolAmongFalsePatterns)
+{
+	// the three finder patterns of a big symbol (5 pixel modules, 207 modules), each surrounded by 100 slightly bigger
+	// false positive patterns that are all closer than its partners
+	ConcentricPattern tl = {{500, 500}, 35}, tr = {{1500, 500}, 35}, bl = {{500, 1500}, 35};
+	FinderPatterns patterns = {tl, tr, bl};
+	PseudoRandom random(43);
+	for (auto fp : {tl, tr, bl})
+		for (int i = 0; i < 100; ++i)
+			patterns.push_back({fp + PointF(random.next(-250, 250), random.next(-250, 250)), random.next(36, 45)});
+
+	// reading a single symbol, all candidates are considered
+	auto sets = GenerateFinderPatternSets(patterns, 1);
+	EXPECT_TRUE(FindIf(sets, [&](const FinderPatternSet& s) { return s.tl == tl && s.tr == tr && s.bl == bl; }) != sets.end());
+}
+
+TEST(QRDetectorTest, ManySymbols)
+{
+	// more than the former limit of 255 symbols per call
+	constexpr int N = 17;
+	int size = N * PITCH + 4 * 3;
+	auto buf = CreateGrid(N);
+
+	auto opts = ReaderOptions().setFormats(BarcodeFormat::QRCode).setMaxNumberOfSymbols(0);
+	auto barcodes = ReadBarcodes(ImageView(buf.data(), size, size, ImageFormat::Lum), opts);
+	std::set<std::string> texts;
+	for (auto& barcode : barcodes)
+		texts.insert(barcode.text());
+	EXPECT_EQ(Size(barcodes), N * N);
+	EXPECT_EQ(Size(texts), N * N);
+}
@@ -193,7 +193,7 @@ static jobject NewError(JNIEnv* env, const Error& error)
 {
 	jclass cls = env->FindClass(PACKAGE "Error");
 	jmethodID midInit = env->GetMethodID(cls, "<init>", "(L" PACKAGE "ErrorType;" "Ljava/lang/String;)V");
-	return env->NewObject(cls, midInit, NewEnum(env, JavaErrorTypeName(error.type()), "ErrorType"), C2JString(env, error.msg()));
+	return env->NewObject(cls, midInit, NewEnum(env, JavaErrorTypeName(error.type()), "ErrorType"), C2JString(env, std::string(error.msg())));
 }
 
 static jobject NewResult(JNIEnv* env, const Barcode& result)
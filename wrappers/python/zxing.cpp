@@ -42,7 +42,7 @@ std::ostream& operator<<(std::ostream& os, const Position& points) {
 
 auto read_barcodes_impl(py::object _image, const BarcodeFormats& formats, bool try_rotate, bool try_downscale, TextMode text_mode,
 						Binarizer binarizer, bool is_pure, EanAddOnSymbol ean_add_on_symbol, bool return_errors,
-						uint8_t max_number_of_symbols = 0xff)
+						uint16_t max_number_of_symbols = 0xff)
 {
 	const auto opts = ReaderOptions()
 		.setFormats(formats)
@@ -378,7 +378,7 @@ PYBIND11_MODULE(zxingcpp, m)
 		.def_property_readonly("valid", &Barcode::isValid,
 			":return: whether or not barcode is valid (i.e. a symbol was found and decoded)\n"
 			":rtype: bool")
-		.def_property_readonly("text", [](const Barcode& res) { return res.text(); },
+		.def_property_readonly("text", [](const Barcode& res) { return res.textView(); },
 			":return: text of the decoded symbol (see also TextMode parameter)\n"
 			":rtype: str")
 		.def_property_readonly("bytes", [](const Barcode& res) { return py::bytes(res.bytes().asString()); },